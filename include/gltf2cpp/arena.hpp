@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+namespace gltf2cpp {
+///
+/// \brief Thread-safe monotonic memory resource.
+///
+/// Deallocation is a no-op: all memory is released in one go when the Arena is destroyed.
+/// Pass a std::shared_ptr<Arena> as ParseOptions::resource to allocate all decoded data of an asset from it;
+/// the Arena will then be destroyed along with the last array allocated from it.
+///
+class Arena : public std::pmr::memory_resource {
+  public:
+	///
+	/// \brief Construct an Arena.
+	/// \param initial_size Size of the first block to allocate (subsequent blocks grow geometrically)
+	///
+	explicit Arena(std::size_t initial_size = 1024u * 1024u) : m_resource(initial_size) {}
+
+	///
+	/// \brief Obtain the total number of bytes allocated from this Arena.
+	/// \returns Total bytes allocated
+	///
+	std::size_t allocated() const {
+		auto lock = std::scoped_lock{m_mutex};
+		return m_allocated;
+	}
+
+  private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) final {
+		auto lock = std::scoped_lock{m_mutex};
+		m_allocated += bytes;
+		return m_resource.allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void*, std::size_t, std::size_t) final {}
+
+	bool do_is_equal(std::pmr::memory_resource const& other) const noexcept final { return this == &other; }
+
+	mutable std::mutex m_mutex{};
+	std::pmr::monotonic_buffer_resource m_resource;
+	std::size_t m_allocated{};
+};
+} // namespace gltf2cpp
@@ -0,0 +1,52 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+
+namespace gltf2cpp {
+///
+/// \brief Compute the bounds of a set of points.
+/// \param positions Points to bound
+/// \returns Smallest Aabb containing all positions (empty if there are none)
+///
+/// Vectorized with SSE2 / NEON where available.
+///
+Aabb compute_aabb(std::span<Vec<3> const> positions);
+
+///
+/// \brief Obtain the sphere enclosing a box.
+/// \param aabb Box to enclose
+/// \returns Sphere centred on aabb, passing through its corners (zero if aabb is empty)
+///
+Sphere bounding_sphere(Aabb const& aabb);
+
+///
+/// \brief Transform a box.
+/// \param aabb Box to transform
+/// \param matrix Affine (column major) transform
+/// \returns Smallest Aabb containing the transformed box (empty if aabb is empty)
+///
+Aabb transform_aabb(Aabb const& aabb, Mat4x4 const& matrix);
+
+///
+/// \brief World space bounds of Nodes and Scenes.
+///
+struct WorldBounds {
+	///
+	/// \brief Bounds of each Node's Mesh (empty if it has none), indexed by Node.
+	///
+	std::vector<Aabb> nodes{};
+	///
+	/// \brief Bounds of all the Nodes in each Scene, indexed by Scene.
+	///
+	std::vector<Aabb> scenes{};
+};
+
+///
+/// \brief Compute world space bounds for each Node and Scene.
+/// \param root Parsed asset
+/// \returns Bounds of each Node and Scene
+///
+/// Combines Mesh::Primitive::aabb with world matrices (TransformHierarchy): no vertices are read.
+/// Skinned Meshes are bounded in their bind pose (via the Node's Transform); morph targets are not accounted for.
+///
+WorldBounds world_bounds(Root const& root);
+} // namespace gltf2cpp
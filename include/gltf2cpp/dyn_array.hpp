@@ -1,12 +1,44 @@
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <memory_resource>
 #include <span>
+#include <type_traits>
 
 namespace gltf2cpp {
 ///
-/// \brief Basic dynamic array (wrapper over std::unique_ptr<T[]> + size).
+/// \brief Allocation parameters for DynArray.
+///
+struct Allocation {
+	///
+	/// \brief Memory resource to allocate from (uses the heap if null).
+	///
+	/// Kept alive until the storage (and all views into it) is destroyed.
+	///
+	std::shared_ptr<std::pmr::memory_resource> resource{};
+	///
+	/// \brief Minimum alignment of the storage in bytes (eg 64 for aligned SIMD loads), a power of two.
+	///
+	/// The storage is always at least aligned for its element type.
+	///
+	std::size_t alignment{};
+	///
+	/// \brief Whether to value-initialize (zero) the storage.
+	///
+	/// Uninitialized storage is only supported for trivially default constructible types,
+	/// and must be fully overwritten before being read.
+	///
+	bool initialize{true};
+};
+
+///
+/// \brief Basic dynamic array (wrapper over std::shared_ptr<T[]> + size).
+///
+/// Instances are move-only, but views into (sub-ranges of) the stored data can be
+/// obtained via share(): these extend the lifetime of the storage instead of copying it.
 ///
 template <typename T>
 class DynArray {
@@ -20,19 +52,74 @@ class DynArray {
 	/// \brief Construct a dynamic array of given size.
 	/// \param size Desired size of dynamic array
 	///
-	explicit DynArray(std::size_t size) : m_data(std::make_unique<T[]>(size)), m_size(size) {}
+	explicit DynArray(std::size_t size) : m_data(new T[size]()), m_size(size) {}
+	///
+	/// \brief Construct a dynamic array of given size with custom allocation.
+	/// \param size Desired size of dynamic array
+	/// \param allocation Memory resource, alignment, and initialization to use
+	///
+	explicit DynArray(std::size_t size, Allocation allocation) : m_data(allocate(size, std::move(allocation))), m_size(size) {}
 	///
 	/// \brief Transfer ownership of another dynamic array.
 	/// \param data Data to transfer ownership of
 	/// \param size Size of the data being transferred
 	///
 	explicit DynArray(std::unique_ptr<T[]>&& data, std::size_t size) : m_data(std::move(data)), m_size(size) {}
+	///
+	/// \brief Share ownership of existing storage.
+	/// \param data Storage to share ownership of
+	/// \param size Size of the data being shared
+	///
+	explicit DynArray(std::shared_ptr<T[]> data, std::size_t size) : m_data(std::move(data)), m_size(size) {}
 
 	///
 	/// \brief Construct a dynamic array and populate it with the given data.
 	/// \param data Data to copy
+	/// \param allocation Memory resource and alignment to use (storage is never initialized before copying)
 	///
-	explicit DynArray(std::span<T const> data) : DynArray(data.size()) { std::memcpy(m_data.get(), data.data(), data.size()); }
+	explicit DynArray(std::span<T const> data, Allocation allocation = {}) : DynArray(data.size(), uninitialized(std::move(allocation))) {
+		if (!data.empty()) { std::memcpy(m_data.get(), data.data(), data.size_bytes()); }
+	}
+
+	DynArray(DynArray&&) = default;
+	DynArray& operator=(DynArray&&) = default;
+	DynArray(DynArray const&) = delete;
+	DynArray& operator=(DynArray const&) = delete;
+
+	///
+	/// \brief Obtain a view into a sub-range of the stored data.
+	/// \param offset Index of the first element to view
+	/// \param count Number of elements to view
+	/// \returns DynArray sharing ownership of the stored data
+	///
+	DynArray share(std::size_t offset, std::size_t count) const {
+		assert(offset + count <= size());
+		auto ret = DynArray{std::shared_ptr<T[]>{m_data, m_data.get() + offset}, count};
+		ret.debug_refresh();
+		return ret;
+	}
+	///
+	/// \brief Obtain a view into the stored data.
+	/// \returns DynArray sharing ownership of the stored data
+	///
+	DynArray share() const { return share(0u, size()); }
+	///
+	/// \brief Obtain a view into a sub-range of the stored data, as another type.
+	/// \param offset Index of the first element to view
+	/// \param count Number of objects of type U to view
+	/// \returns DynArray<U> sharing ownership of the stored data
+	///
+	/// The viewed range must be suitably aligned for U, and fit within the stored data.
+	///
+	template <typename U>
+	DynArray<U> reinterpret(std::size_t offset, std::size_t count) const {
+		auto* ptr = m_data.get() + offset;
+		assert(reinterpret_cast<std::uintptr_t>(ptr) % alignof(U) == 0);
+		assert((offset * sizeof(T)) + (count * sizeof(U)) <= size() * sizeof(T));
+		auto ret = DynArray<U>{std::shared_ptr<U[]>{m_data, reinterpret_cast<U*>(ptr)}, count};
+		ret.debug_refresh();
+		return ret;
+	}
 
 	///
 	/// \brief Obtain a pointer to the data.
@@ -48,7 +135,7 @@ class DynArray {
 	/// \brief Obtain a span into the stored data.
 	/// \returns Span into stored data
 	///
-	std::span<T> span() const { return {m_data.get(), m_size}; }
+	std::span<T> span() const { return {m_data.get(), size()}; }
 
 	///
 	/// \brief Obtain a reference to the object at index.
@@ -81,7 +168,35 @@ class DynArray {
 	}
 
   private:
-	std::unique_ptr<T[]> m_data{};
+	static Allocation uninitialized(Allocation allocation) {
+		allocation.initialize = false;
+		return allocation;
+	}
+
+	static std::shared_ptr<T[]> allocate(std::size_t size, Allocation allocation) {
+		assert((allocation.alignment & (allocation.alignment - 1)) == 0);
+		auto const alignment = std::max(allocation.alignment, alignof(T));
+		// new_delete_resource supports over-aligned allocations (via aligned operator new)
+		auto* resource = allocation.resource ? allocation.resource.get() : std::pmr::new_delete_resource();
+		auto* ptr = static_cast<T*>(resource->allocate(size * sizeof(T), alignment));
+		if constexpr (std::is_trivially_default_constructible_v<T>) {
+			if (!allocation.initialize) {
+				std::uninitialized_default_construct_n(ptr, size);
+			} else {
+				std::uninitialized_value_construct_n(ptr, size);
+			}
+		} else {
+			assert(allocation.initialize);
+			std::uninitialized_value_construct_n(ptr, size);
+		}
+		auto deleter = [owner = std::move(allocation.resource), resource, size, alignment](T* ptr) {
+			std::destroy_n(ptr, size);
+			resource->deallocate(ptr, size * sizeof(T), alignment);
+		};
+		return std::shared_ptr<T[]>{ptr, std::move(deleter)};
+	}
+
+	std::shared_ptr<T[]> m_data{};
 	std::size_t m_size{};
 
 #if defined(GLTF2CPP_DYNARRAY_DEBUG_VIEW)
@@ -6,6 +6,9 @@
 #include <array>
 #include <cstring>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <unordered_map>
 #include <variant>
@@ -40,6 +43,13 @@ using Mat4x4 = std::array<Vec<4>, 4>;
 ///
 using GetBytes = std::function<std::span<std::byte const>(std::string_view)>;
 
+///
+/// \brief Alias for callable that returns owned bytes given a URI.
+///
+/// Returned arrays are adopted by Buffers / Images as-is (not copied), eg memory mapped files.
+///
+using LoadBytes = std::function<ByteArray(std::string_view)>;
+
 ///
 /// \brief GLTF Material Alpha Mode.
 ///
@@ -152,12 +162,33 @@ constexpr auto from_component_type() {
 template <ComponentType C>
 using FromComponentType = decltype(from_component_type<C>());
 
+///
+/// \brief Layout of an Accessor's elements within its BufferView.
+///
+/// min and max (if present) contain one value per component.
+///
+struct AccessorLayout {
+	std::vector<double> min{};
+	std::vector<double> max{};
+	std::size_t count{};
+	std::size_t component_coeff{};
+	std::optional<std::size_t> stride{};
+
+	constexpr std::size_t container_size() const { return count * component_coeff; }
+};
+
+namespace detail {
+struct AccessorStorage;
+}
+
 ///
 /// \brief GLTF Transform encoded as Translation, Rotation, Scale.
 ///
+/// rotation is a unit quaternion (x, y, z, w).
+///
 struct Trs {
 	Vec<3> translation{};
-	Vec<4> rotation{{1.0f, 0.0f, 0.0f, 0.0f}};
+	Vec<4> rotation{{0.0f, 0.0f, 0.0f, 1.0f}};
 	Vec<3> scale{Vec<3>{{1.0f, 1.0f, 1.0f}}};
 };
 
@@ -166,6 +197,50 @@ struct Trs {
 ///
 using Transform = std::variant<Trs, Mat4x4>;
 
+///
+/// \brief Axis aligned bounding box.
+///
+/// Default constructed boxes are empty (min > max): merging anything into one yields that thing.
+///
+struct Aabb {
+	Vec<3> min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+	Vec<3> max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+	constexpr bool empty() const { return min[0] > max[0] || min[1] > max[1] || min[2] > max[2]; }
+	constexpr Vec<3> center() const { return {(min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f}; }
+	///
+	/// \brief Half of the size along each axis.
+	///
+	constexpr Vec<3> extent() const { return {(max[0] - min[0]) * 0.5f, (max[1] - min[1]) * 0.5f, (max[2] - min[2]) * 0.5f}; }
+
+	constexpr Aabb& merge(Vec<3> const& point) {
+		for (std::size_t i = 0; i < 3; ++i) {
+			if (point[i] < min[i]) { min[i] = point[i]; }
+			if (point[i] > max[i]) { max[i] = point[i]; }
+		}
+		return *this;
+	}
+
+	constexpr Aabb& merge(Aabb const& other) {
+		if (other.empty()) { return *this; }
+		return merge(other.min).merge(other.max);
+	}
+
+	bool operator==(Aabb const&) const = default;
+};
+
+///
+/// \brief Bounding sphere.
+///
+struct Sphere {
+	Vec<3> center{};
+	float radius{};
+
+	bool operator==(Sphere const&) const = default;
+};
+
+class Indices;
+
 ///
 /// \brief GLTF Accessor.
 ///
@@ -174,6 +249,13 @@ using Transform = std::variant<Trs, Mat4x4>;
 /// Eg, Data for Type::eVec4 / ComponentType::Float will contain 4x float components
 /// for each element (and not a Vec<4> for each element).
 ///
+/// Tightly packed and suitably aligned data (that does not need clamping to min / max)
+/// is not copied: such arrays are views into (and share ownership of) the source Buffer's bytes.
+///
+/// Data is decoded on first access via data() (unless decoded eagerly during parsing);
+/// the layout required to do so is recorded in layout.
+/// Sparse accessors are never decoded eagerly: sparse exposes their substitutions as-is.
+///
 struct Accessor {
 	template <ComponentType C>
 	using ComponentArray = DynArray<FromComponentType<C>>;
@@ -189,17 +271,37 @@ struct Accessor {
 
 	enum class Type { eScalar, eVec2, eVec3, eVec4, eMat2, eMat3, eMat4, eCOUNT_ };
 
+	///
+	/// \brief GLTF Accessor Sparse storage.
+	///
+	/// Each (indices[i], values[i]) pair substitutes the element at indices[i]; values contains
+	/// type_coeff(type) components of component_type per index.
+	/// data() applies these to (a copy of) the base data; use this directly to avoid densifying.
+	///
+	struct Sparse {
+		std::vector<std::uint32_t> indices{};
+		Data values{};
+		dj::Json extensions{};
+		dj::Json extras{};
+	};
+
 	std::string name{};
 	std::optional<Index<BufferView>> buffer_view{};
 	std::size_t byte_offset{};
-	Data data{};
 	ComponentType component_type{};
 	Type type{};
 	std::size_t count{};
 	bool normalized{};
+	AccessorLayout layout{};
+	std::optional<Sparse> sparse{};
 	dj::Json extensions{};
 	dj::Json extras{};
 
+	///
+	/// \brief Decoding state (shared between copies).
+	///
+	std::shared_ptr<detail::AccessorStorage> storage{};
+
 	///
 	/// \brief Obtain the width multiplier for type.
 	/// \param type Type to get width multiplier for
@@ -215,6 +317,27 @@ struct Accessor {
 	///
 	static Type to_type(std::string_view key);
 
+	///
+	/// \brief Obtain the decoded data.
+	/// \returns Data as a flat array of ComponentType
+	///
+	/// Decodes the data on first access; thread-safe.
+	/// Empty if storage has been released (ParseOptions::Keep::accessors).
+	///
+	Data const& data() const;
+	///
+	/// \brief Check if the data has been decoded.
+	/// \returns true if data() will not need to decode
+	///
+	bool decoded() const;
+	///
+	/// \brief Check if the source data exceeds the declared min / max.
+	/// \returns true if any component lies outside its declared bounds
+	///
+	/// Decodes the data if required. Always false if parsed with ParseOptions::Bounds::eSkip.
+	///
+	bool out_of_bounds() const;
+
 	///
 	/// \brief Obtain data as a vector of u32.
 	/// \returns Data as std::vector of u32
@@ -222,12 +345,21 @@ struct Accessor {
 	/// component_type must be unsigned.
 	///
 	std::vector<std::uint32_t> to_u32() const;
+	///
+	/// \brief Obtain data as vertex Indices (at native width).
+	/// \returns Indices: u8 data is widened to u16, u16 and u32 are copied as-is
+	///
+	/// component_type must be unsigned.
+	///
+	Indices to_indices() const;
 
 	///
 	/// \brief Obtain data as a vector of Vec<Dim>.
 	/// \returns Data as std::vector of Vec<Dim>
 	///
-	/// type must be Type::eVecI (I == Dim), and component_type must be ComponentType::eFloat.
+	/// type must be Type::eVecI (I == Dim).
+	/// Integer components are dequantized: if normalized is set they are mapped to [0, 1] (unsigned) / [-1, 1] (signed)
+	/// as per the GLTF spec, otherwise they are converted as-is (KHR_mesh_quantization).
 	///
 	template <std::size_t Dim>
 	std::vector<Vec<Dim>> to_vec() const;
@@ -241,6 +373,66 @@ struct Accessor {
 	std::vector<Mat4x4> to_mat4() const;
 };
 
+///
+/// \brief Vertex indices, stored at their native width (u16 or u32).
+///
+/// Indices can be uploaded as-is (eg as VK_INDEX_TYPE_UINT16 / UINT32) via bytes() and component_type().
+/// Elements are read as u32 regardless of the stored width; use to_u32() to widen explicitly.
+///
+class Indices {
+  public:
+	using Storage = std::variant<std::vector<std::uint16_t>, std::vector<std::uint32_t>>;
+
+	Indices() = default;
+	explicit Indices(std::vector<std::uint16_t> u16) : m_storage(std::move(u16)) {}
+	explicit Indices(std::vector<std::uint32_t> u32) : m_storage(std::move(u32)) {}
+
+	std::size_t size() const {
+		return std::visit([](auto const& v) { return v.size(); }, m_storage);
+	}
+	bool empty() const { return size() == 0; }
+
+	std::uint32_t operator[](std::size_t const index) const {
+		if (auto const* ret = std::get_if<std::vector<std::uint16_t>>(&m_storage)) { return (*ret)[index]; }
+		return std::get<std::vector<std::uint32_t>>(m_storage)[index];
+	}
+
+	///
+	/// \brief Obtain the stored width.
+	/// \returns ComponentType::eUnsignedShort or ComponentType::eUnsignedInt
+	///
+	ComponentType component_type() const { return is_u16() ? ComponentType::eUnsignedShort : ComponentType::eUnsignedInt; }
+	bool is_u16() const { return std::holds_alternative<std::vector<std::uint16_t>>(m_storage); }
+
+	///
+	/// \brief Obtain u16 indices.
+	/// \returns Indices if stored as u16, else an empty span
+	///
+	std::span<std::uint16_t const> u16() const;
+	///
+	/// \brief Obtain u32 indices.
+	/// \returns Indices if stored as u32, else an empty span
+	///
+	std::span<std::uint32_t const> u32() const;
+	///
+	/// \brief Obtain the raw bytes of the indices (at the stored width).
+	///
+	std::span<std::byte const> bytes() const;
+	///
+	/// \brief Obtain the indices widened to u32.
+	///
+	/// u16 indices are widened using SIMD where available.
+	///
+	std::vector<std::uint32_t> to_u32() const;
+
+	Storage const& storage() const { return m_storage; }
+
+	bool operator==(Indices const&) const = default;
+
+  private:
+	Storage m_storage{};
+};
+
 struct Node;
 
 ///
@@ -354,21 +546,18 @@ using AttributeMap = std::unordered_map<std::string, Index<Accessor>>;
 ///
 /// Geometry represents all the Attributes in a Mesh Primitive.
 /// Positions, normals, tangents, tex_coords, colors, and indices are pre-parsed for convenience.
+/// indices are kept at their native width (u8 indices are widened to u16).
 ///
 /// tex_coords and colors are nested vectors, where the Ith element corresponds to SEMANTIC_I,
 /// eg. tex_coords[2] is populated from the TEXCOORD_2 Attribute's Accessor.
 ///
-/// These vectors (except indices and joints) will only be populated if the corresponding
-/// Accessor's ComponentType is eFloat.
-/// For other component types, obtain and use the Accessor directly.
-/// Since the POSITION Attribute is required to be in Accessor::Type::eVec3 / ComponentType::eFloat
-/// format by the GLTF spec, .positions is always expected to be populated.
+/// Quantized / normalized integer Attributes (core spec and KHR_mesh_quantization) are dequantized
+/// into floats, so these vectors are populated regardless of the Accessor's ComponentType.
+/// Obtain and use the Accessor directly to access the original (quantized) data.
+/// .positions is always expected to be populated (unless parsed without ParseOptions::Keep::geometry).
 /// normals, tangents, tex_coords, and colors will either be empty or the same size as positions.
 /// joints and weights will have the same size.
 ///
-/// Note: weights is only parsed if the ComponentType is eFloat. Otherwise the corresponding
-/// array will be empty.
-///
 struct Geometry {
 	AttributeMap attributes{};
 	std::vector<Vec<3>> positions{};
@@ -376,7 +565,7 @@ struct Geometry {
 	std::vector<Vec<4>> tangents{};
 	std::vector<std::vector<Vec<2>>> tex_coords{};
 	std::vector<std::vector<Vec<3>>> colors{};
-	std::vector<std::uint32_t> indices{};
+	Indices indices{};
 
 	std::vector<std::vector<UVec<4>>> joints{};
 	std::vector<std::vector<Vec<4>>> weights{};
@@ -468,6 +657,17 @@ struct Mesh {
 		std::optional<Index<Accessor>> indices{};
 		std::optional<Index<Material>> material{};
 		std::vector<MorphTarget> targets{};
+		///
+		/// \brief Local space bounds of the POSITION Attribute (empty if unknown).
+		///
+		/// Taken from the Accessor's min / max when present (and trustworthy), otherwise computed from Geometry.
+		/// Does not account for morph targets or skinning.
+		///
+		Aabb aabb{};
+		///
+		/// \brief Sphere enclosing aabb.
+		///
+		Sphere sphere{};
 		PrimitiveMode mode{PrimitiveMode::eTriangles};
 		dj::Json extensions{};
 		dj::Json extras{};
@@ -559,6 +759,18 @@ struct Metadata {
 	std::vector<std::string> extensions_required{};
 };
 
+///
+/// \brief Memory used by a Root, in bytes.
+///
+struct MemoryUsage {
+	std::size_t buffers{};
+	std::size_t accessors{};
+	std::size_t geometry{};
+	std::size_t images{};
+
+	constexpr std::size_t total() const { return buffers + accessors + geometry + images; }
+};
+
 ///
 /// \brief GLTF root.
 ///
@@ -587,6 +799,15 @@ struct Root {
 	dj::Json extras{};
 	Asset asset{};
 
+	///
+	/// \brief Obtain the memory used by buffers, accessors, geometry, and images.
+	/// \returns Breakdown of memory used, in bytes
+	///
+	/// Accessors and Images that are views into (retained) Buffers are not counted twice.
+	/// Does not decode any Accessors.
+	///
+	MemoryUsage memory_usage() const;
+
 	///
 	/// \brief Check if this instance represents a parsed GLTF asset.
 	/// \returns true if asset.version has been set
@@ -596,6 +817,212 @@ struct Root {
 	explicit operator bool() const { return asset.version > Version{}; }
 };
 
+///
+/// \brief GLB (binary GLTF) container.
+///
+struct Glb {
+	///
+	/// \brief Parsed JSON chunk.
+	///
+	dj::Json json{};
+	///
+	/// \brief BIN chunk (if present), sharing ownership of the container bytes.
+	///
+	ByteArray bin{};
+
+	///
+	/// \brief Check if bytes start with the GLB magic.
+	/// \param bytes Bytes to check
+	/// \returns true if bytes represent a GLB container
+	///
+	static bool is_glb(std::span<std::byte const> bytes);
+	///
+	/// \brief Split a GLB container into its JSON and BIN chunks.
+	/// \param bytes Bytes of the entire GLB container
+	/// \returns Glb instance (json will be null if bytes are not a valid GLB container)
+	///
+	/// The BIN chunk is not copied: bin is a view into bytes.
+	///
+	static Glb from(ByteArray const& bytes);
+};
+
+///
+/// \brief Callbacks to receive objects as soon as they have been parsed (streaming).
+///
+/// Objects passed to a callback are not stored in Root (default-constructed placeholders remain
+/// at their indices): move from them to take ownership.
+/// Callbacks are invoked from worker threads if ParseOptions::threads is not 1, and must then be thread-safe.
+///
+struct Visitor {
+	///
+	/// \brief Called with each parsed Mesh Primitive.
+	///
+	/// accessors is Root::accessors: the storage of Accessors referenced only by Mesh Primitives is released
+	/// once every Primitive referencing them has been visited. Only the Accessors referenced by primitive (its
+	/// indices, and the Attributes of its Geometry and MorphTargets) may be read: other threads may be releasing
+	/// any other Accessor's storage concurrently.
+	/// Accessors cannot be copied; to keep data beyond the callback, share() the DynArray in Accessor::data()
+	/// (eg std::visit([](auto const& d) { return Accessor::Data{d.share()}; }, accessor.data())).
+	/// Combine with ParseOptions::Decode::eDeferred (and Keep::buffers = false) to bound peak memory.
+	///
+	std::function<void(Index<Mesh> mesh, std::size_t index, Mesh::Primitive& primitive, std::span<Accessor const> accessors)> on_primitive{};
+	///
+	/// \brief Called with each parsed Image.
+	///
+	std::function<void(Index<Image> index, Image& image)> on_image{};
+	///
+	/// \brief Called with each parsed Animation.
+	///
+	/// Animation::Sampler::input views Accessor data: these Accessors are retained in Root.
+	///
+	std::function<void(Index<Animation> index, Animation& animation, std::span<Accessor const> accessors)> on_animation{};
+};
+
+///
+/// \brief Options for parsing GLTF data.
+///
+struct ParseOptions {
+	///
+	/// \brief When to decode Accessor data.
+	///
+	enum class Decode {
+		eEager,	   // decode all accessors while parsing (interleaved accessors in one pass per BufferView)
+		eDeferred, // decode each accessor on first access (Accessor::data())
+	};
+
+	///
+	/// \brief How to handle Accessor min / max.
+	///
+	enum class Bounds {
+		eSkip,	   // ignore min / max
+		eValidate, // record whether data exceeds min / max (Accessor::out_of_bounds())
+		eClamp,	   // eValidate, and clamp data to min / max
+	};
+
+	///
+	/// \brief Layers of vertex data to keep after parsing.
+	///
+	/// Vertex data is stored in up to three layers: Root::buffers (raw bytes), Accessor::data()
+	/// (decoded components), and Geometry / MorphTarget (pre-parsed vectors).
+	///
+	struct Keep {
+		///
+		/// \brief Keep the bytes of Root::buffers.
+		///
+		/// Buffer entries are retained (for stable indices), but their bytes are released: this memory
+		/// is freed unless it is still viewed by Accessors or Images (BufferView::to_span() will fail).
+		///
+		bool buffers{true};
+		///
+		/// \brief Keep the storage of Accessors covered by Geometry / MorphTarget.
+		///
+		/// If false, the storage of Accessors referenced by the pre-parsed Mesh Primitive attributes and indices
+		/// is released once they are no longer needed. Accessors used by Animations, Skins, or custom
+		/// attributes are always kept.
+		///
+		bool accessors{true};
+		///
+		/// \brief Populate Geometry / MorphTarget vectors (attributes are always populated).
+		///
+		bool geometry{true};
+	};
+
+	///
+	/// \brief Post-processing applied to the Geometry of each Mesh Primitive (requires Keep::geometry).
+	///
+	/// Stages run in the order declared, in parallel across primitives (see threads), before Visitor::on_primitive.
+	/// If only one primitive is parsed, weld, normals, and tangents split its work across threads instead (if it is large enough).
+	/// Only Geometry / MorphTarget vectors (and indices) are modified: Accessors always reflect the source data.
+	/// Each stage is also available on demand via <gltf2cpp/process.hpp>.
+	///
+	struct Process {
+		///
+		/// \brief Convert strips, fans, and loops to lists, and give unindexed primitives indices (see normalize_topology()).
+		///
+		/// Indexed primitives are converted while decoding their indices, in the same pass.
+		///
+		bool normalize_topology{};
+		///
+		/// \brief Merge duplicate vertices (see weld()); unindexed primitives are given indices.
+		///
+		bool weld{};
+		///
+		/// \brief Grid size to quantize float components to when welding (0 to only merge identical vertices).
+		///
+		float weld_epsilon{};
+		///
+		/// \brief Generate normals for triangle lists without a NORMAL Attribute (see generate_normals()).
+		///
+		bool normals{};
+		///
+		/// \brief Crease angle (radians) of generated normals: 0 for flat normals (as per the GLTF spec), else smooth normals.
+		///
+		float crease_angle{};
+		///
+		/// \brief Generate tangents for triangle lists without a TANGENT Attribute (see generate_tangents()).
+		///
+		/// Requires normals and TEXCOORD_0.
+		///
+		bool tangents{};
+		///
+		/// \brief Reorder indexed triangle lists for vertex cache locality, and their vertices for fetch locality.
+		///
+		bool optimize{};
+	};
+
+	///
+	/// \brief Subset of the asset to parse.
+	///
+	/// Entries that are not selected are left as default-constructed placeholders, so indices remain stable.
+	/// Only the Buffers / Accessors referenced by selected entries are loaded / decoded (all of them if nothing
+	/// is filtered). Nodes, scenes, materials, textures, samplers, and cameras are always parsed.
+	///
+	struct Select {
+		///
+		/// \brief Only parse what is reachable from this scene's root nodes.
+		///
+		/// Selects meshes and skins of reachable nodes, animations targeting reachable nodes,
+		/// and the images used by the reachable meshes' materials.
+		///
+		std::optional<Index<Scene>> scene{};
+		bool meshes{true};
+		bool images{true};
+		bool animations{true};
+		bool skins{true};
+
+		bool all() const { return !scene && meshes && images && animations && skins; }
+	};
+
+	Decode accessors{Decode::eEager};
+	Bounds bounds{Bounds::eClamp};
+	Keep keep{};
+	Process process{};
+	Select select{};
+	Visitor visitor{};
+	///
+	/// \brief Memory resource to allocate decoded data from (uses the heap if null).
+	///
+	/// Used for all bytes copied / decoded by the parser: buffers, images, and Accessor data (including
+	/// deferred decoding). The resource is kept alive by these allocations, and must be thread-safe if
+	/// threads is not 1. Use an Arena to place an asset in a few large blocks and free it in one go.
+	///
+	std::shared_ptr<std::pmr::memory_resource> resource{};
+	///
+	/// \brief Minimum alignment of data allocated by the parser (0 for natural alignment).
+	///
+	/// Eg 64 to use aligned SIMD loads on decoded data. Zero-copy views into buffers are only as aligned as their offsets.
+	///
+	std::size_t alignment{};
+	///
+	/// \brief Number of threads to parse with (0 for hardware concurrency).
+	///
+	/// Buffers, accessors, images, mesh primitives, animations and skins are processed in parallel.
+	/// The parsed Root is identical regardless of the thread count, but GetBytes / LoadBytes
+	/// must be thread-safe if this is not 1.
+	///
+	std::size_t threads{1};
+};
+
 ///
 /// \brief Parser to obtain Metadata / Root given a Json and GetBytes.
 ///
@@ -604,6 +1031,13 @@ struct Parser {
 	/// \brief Json to parse.
 	///
 	dj::Json const& json;
+	///
+	/// \brief BIN chunk of a GLB container (optional).
+	///
+	/// If present, this will be used as the first buffer (which must not have a uri),
+	/// and will be shared with Root instead of being copied.
+	///
+	ByteArray bin{};
 
 	///
 	/// \brief Obtain Metadata.
@@ -613,23 +1047,43 @@ struct Parser {
 	///
 	/// \brief Parse GLTF data.
 	/// \param get_bytes Callable to load bytes given a URI (relative to the input JSON)
+	/// \param options Parse options
+	/// \returns Parsed GLTF Root
+	///
+	Root parse(GetBytes const& get_bytes, ParseOptions const& options = {}) const;
+	///
+	/// \brief Parse GLTF data, adopting loaded bytes instead of copying them.
+	/// \param load_bytes Callable to load owned bytes given a URI (relative to the input JSON)
+	/// \param options Parse options
 	/// \returns Parsed GLTF Root
 	///
-	Root parse(GetBytes const& get_bytes) const;
+	Root parse_owning(LoadBytes const& load_bytes, ParseOptions const& options = {}) const;
 };
 
 ///
-/// \brief Parse json as GLTF.
-/// \param json_path path to .gltf JSON
+/// \brief Memory map a file.
+/// \param path Path to file to map
+/// \returns ByteArray referencing the mapping (empty on failure)
+///
+/// The mapping is private (copy-on-write) and remains valid as long as the
+/// returned array (or any array sharing it) is alive.
+///
+ByteArray map_file(char const* path);
+
+///
+/// \brief Parse file as GLTF.
+/// \param path path to .gltf JSON or .glb binary
+/// \param options Parse options
 /// \returns Parsed GLTF Root
 ///
-Root parse(char const* json_path);
+Root parse(char const* path, ParseOptions const& options = {});
 
 // impl
 
 namespace detail {
 std::string print_error(char const* msg);
 void expect(bool pred, char const* expr) noexcept(false);
+void dequantize(Accessor::Data const& data, bool normalized, std::span<float> out);
 } // namespace detail
 
 #define GLTF2CPP_EXPECT(expr) detail::expect(!!(expr), #expr)
@@ -650,12 +1104,12 @@ constexpr std::size_t Accessor::type_coeff(Accessor::Type type) {
 template <std::size_t Dim>
 std::vector<Vec<Dim>> Accessor::to_vec() const {
 	GLTF2CPP_EXPECT(type_coeff(type) == Dim);
-	GLTF2CPP_EXPECT(std::holds_alternative<Float>(data));
-	auto ret = std::vector<Vec<Dim>>{};
-	auto const& d = std::get<Float>(data);
-	GLTF2CPP_EXPECT(d.size() % Dim == 0);
-	ret.resize(d.size() / Dim);
-	std::memcpy(ret.data(), d.data(), d.span().size_bytes());
+	auto const& d = data();
+	auto const size = std::visit([](auto const& d) { return d.size(); }, d);
+	GLTF2CPP_EXPECT(size % Dim == 0);
+	auto ret = std::vector<Vec<Dim>>(size / Dim);
+	if (ret.empty()) { return ret; }
+	detail::dequantize(d, normalized, {ret.front().data(), size});
 	return ret;
 }
 
@@ -0,0 +1,102 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+
+namespace gltf2cpp {
+///
+/// \brief Convert a Transform to a (column major) matrix.
+/// \param transform Transform to convert
+/// \returns Translation * Rotation * Scale, or the matrix as-is
+///
+Mat4x4 to_matrix(Transform const& transform);
+
+///
+/// \brief Flattened Node hierarchy for evaluating world transforms.
+///
+/// Nodes reachable from Root::scenes (and any other parentless Nodes) are stored depth first, so that parents precede
+/// their children and each subtree is contiguous. Local Trs are stored as structure of arrays, and converted to matrices
+/// four at a time (SSE2 / NEON where available); world matrices are evaluated in a single linear pass, without recursion.
+///
+/// Changing a local transform marks its entry dirty; update() only re-evaluates dirty entries and their descendants.
+///
+class TransformHierarchy {
+  public:
+	static constexpr std::size_t npos_v{static_cast<std::size_t>(-1)};
+
+	TransformHierarchy() = default;
+
+	///
+	/// \brief Build the hierarchy of root's Nodes, and evaluate their world matrices.
+	/// \param root Parsed asset
+	///
+	/// Throws Error if a Node has an invalid child index.
+	///
+	explicit TransformHierarchy(Root const& root);
+
+	///
+	/// \brief Obtain the number of entries (reachable Nodes).
+	///
+	std::size_t size() const { return m_nodes.size(); }
+	///
+	/// \brief Obtain the Node of each entry.
+	///
+	std::span<Index<Node> const> nodes() const { return m_nodes; }
+	///
+	/// \brief Obtain the parent entry of each entry (npos_v for roots).
+	///
+	std::span<std::size_t const> parents() const { return m_parents; }
+	///
+	/// \brief Obtain the world matrix of each entry (as of the last update()).
+	///
+	std::span<Mat4x4 const> world_matrices() const { return m_world; }
+
+	///
+	/// \brief Obtain the entry of a Node.
+	/// \returns Index into nodes(), or npos_v if node is not part of the hierarchy
+	///
+	std::size_t entry(Index<Node> node) const { return node < m_entries.size() ? m_entries[node] : npos_v; }
+
+	///
+	/// \brief Set the local transform of a Node (takes effect on the next update()).
+	///
+	/// Throws Error if node is not part of the hierarchy.
+	///
+	void set_local(Index<Node> node, Transform const& transform);
+
+	///
+	/// \brief Obtain the local matrix of a Node (as of the last update()).
+	///
+	/// Throws Error if node is not part of the hierarchy.
+	///
+	Mat4x4 const& local(Index<Node> node) const;
+	///
+	/// \brief Obtain the world matrix of a Node (as of the last update()).
+	///
+	/// Throws Error if node is not part of the hierarchy.
+	///
+	Mat4x4 const& world(Index<Node> node) const;
+
+	///
+	/// \brief Re-evaluate the world matrices of dirty entries and their descendants.
+	/// \returns Number of world matrices evaluated
+	///
+	std::size_t update();
+
+  private:
+	std::size_t checked_entry(Index<Node> node) const;
+
+	std::vector<Index<Node>> m_nodes{};
+	std::vector<std::size_t> m_parents{};
+	std::vector<std::size_t> m_entries{};
+
+	// local Trs, one array per component; padded to a multiple of four entries
+	std::array<std::vector<float>, 3> m_translation{};
+	std::array<std::vector<float>, 4> m_rotation{};
+	std::array<std::vector<float>, 3> m_scale{};
+	// entries whose local transform is a matrix (not derived from Trs)
+	std::vector<std::uint8_t> m_is_matrix{};
+	std::vector<std::uint8_t> m_dirty{};
+
+	std::vector<Mat4x4> m_local{};
+	std::vector<Mat4x4> m_world{};
+};
+} // namespace gltf2cpp
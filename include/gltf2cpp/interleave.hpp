@@ -0,0 +1,67 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+
+namespace gltf2cpp {
+///
+/// \brief Attribute within an interleaved vertex.
+///
+struct VertexAttribute {
+	///
+	/// \brief Attribute semantic (eg "POSITION", "TEXCOORD_0").
+	///
+	std::string semantic{};
+	///
+	/// \brief Component type to write.
+	///
+	ComponentType component_type{ComponentType::eFloat};
+	///
+	/// \brief Number of components to write [1-4].
+	///
+	std::size_t components{3};
+	///
+	/// \brief Whether to write (integer) components normalized.
+	///
+	bool normalized{};
+	///
+	/// \brief Offset of the attribute within a vertex, in bytes.
+	///
+	std::size_t offset{};
+};
+
+///
+/// \brief Runtime description of an interleaved vertex.
+///
+struct VertexLayout {
+	std::vector<VertexAttribute> attributes{};
+	///
+	/// \brief Size of a vertex, in bytes.
+	///
+	std::size_t stride{};
+};
+
+///
+/// \brief Interleaved vertices of a Mesh Primitive.
+///
+struct InterleavedVertices {
+	ByteArray bytes{};
+	std::size_t count{};
+	std::size_t stride{};
+};
+
+///
+/// \brief Write the Attributes of a Mesh Primitive into a single interleaved buffer.
+/// \param primitive Mesh Primitive whose Attributes to write
+/// \param accessors Accessors referenced by primitive (Root::accessors)
+/// \param layout Vertex layout to write
+/// \returns Interleaved vertices
+///
+/// Each Attribute is read directly from its Accessor and converted to the requested format:
+/// integer components are (de)normalized as per the GLTF spec, and floats are rounded and saturated
+/// when writing integers. Geometry is not used.
+/// Missing components are written as 0, except for the fourth, which is written as 1 (eg alpha).
+/// Attributes absent in primitive, and any padding between / after Attributes, are zero-filled.
+///
+/// Throws Error if the layout is invalid (including an invalid ComponentType) or if the Attributes have mismatched counts.
+///
+InterleavedVertices interleave(Mesh::Primitive const& primitive, std::span<Accessor const> accessors, VertexLayout const& layout);
+} // namespace gltf2cpp
@@ -0,0 +1,135 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+
+namespace gltf2cpp {
+///
+/// \brief Convert strips, fans, and loops to lists, and give unindexed primitives indices.
+/// \param primitive Mesh Primitive whose mode and indices to normalize
+/// \returns false if primitive is already an indexed list (or has no vertices); it is left unchanged
+///
+/// eTriangleStrip / eTriangleFan become eTriangles, eLineStrip / eLineLoop become eLines; vertex order follows
+/// the GLTF spec, so winding is preserved. Degenerate triangles (eg strip restarts) are dropped.
+/// Unindexed primitives are given indices (u16 if they fit). Vertices and Accessors are not modified.
+///
+/// Throws Error if the vertex vectors have mismatched sizes.
+///
+bool normalize_topology(Mesh::Primitive& primitive);
+
+///
+/// \brief Parameters for normal generation.
+///
+struct Normals {
+	enum class Mode {
+		eFlat,	 // face normals (as mandated by the GLTF spec for primitives without normals)
+		eSmooth, // angle weighted average of the faces around each vertex, within crease_angle
+	};
+
+	Mode mode{Mode::eFlat};
+	///
+	/// \brief Maximum angle between faces to smooth across, in radians (eSmooth only).
+	///
+	/// Edges between faces at a greater angle are kept sharp: vertices on them are split.
+	///
+	float crease_angle{3.14159265f};
+	///
+	/// \brief Number of threads to generate with (0 for hardware concurrency).
+	///
+	std::size_t threads{1};
+};
+
+///
+/// \brief Generate normals for a triangle list (and normal displacements for its MorphTargets).
+/// \param primitive Mesh Primitive whose Geometry::normals to (over)write
+/// \param normals Generation parameters
+/// \returns false if primitive is not a triangle list or has no vertices; it is left unchanged
+///
+/// Each corner gets the normal of its face (eFlat), or the corner angle weighted sum of the face normals
+/// around its vertex that lie within the crease angle of its own face (eSmooth). Vertices whose corners end up
+/// with different normals are split (copying every other attribute), and indices are updated. Smoothing happens
+/// across shared vertices only: weld unindexed / duplicated vertices first.
+/// MorphTargets with positions but without normals get normal displacements: the normals of the displaced positions
+/// (with the base mesh's creases) minus the base normals.
+/// Faces and vertices are processed in parallel: the output is identical regardless of the thread count.
+///
+/// Throws Error if an index is out of range, or if the vertex vectors have mismatched sizes.
+///
+bool generate_normals(Mesh::Primitive& primitive, Normals const& normals = {});
+
+///
+/// \brief Parameters for tangent generation.
+///
+struct Tangents {
+	///
+	/// \brief Index of the tex_coords to derive tangents from (that of the normal texture).
+	///
+	std::size_t tex_coord{};
+	///
+	/// \brief Number of threads to generate with (0 for hardware concurrency).
+	///
+	std::size_t threads{1};
+};
+
+///
+/// \brief Generate tangents (with bitangent signs) for a triangle list.
+/// \param primitive Mesh Primitive whose Geometry::tangents to (over)write (and vertices / indices to split)
+/// \param tangents Generation parameters
+/// \returns false if primitive is not a triangle list or lacks normals / the tex_coords; it is left unchanged
+///
+/// Follows MikkTSpace: each triangle's tangent and bitangent (from positions and tex_coords) are projected
+/// onto the tangent plane of each corner's normal, and accumulated per vertex weighted by the corner angle.
+/// Tangents are then orthonormalized against the normal, and w is set to the bitangent sign (-1 for mirrored UVs),
+/// such that bitangent = cross(normal, tangent.xyz) * w. Vertices shared across a UV mirror line (whose corners disagree on w)
+/// are split in two, and indices are rebuilt (u16 indices are kept if the vertex count fits); unindexed primitives become indexed.
+/// Triangles are processed in parallel, then vertices in parallel: the output is identical regardless of the thread count.
+///
+/// Throws Error if an index is out of range, or if the vertex vectors have mismatched sizes.
+///
+bool generate_tangents(Mesh::Primitive& primitive, Tangents const& tangents = {});
+
+///
+/// \brief Optimize an indexed triangle list for the post-transform vertex cache and vertex fetch.
+/// \param primitive Mesh Primitive whose indices and Geometry (and MorphTargets) to reorder
+/// \returns false if primitive is not an indexed triangle list (it is left unchanged)
+///
+/// Triangles are reordered for vertex cache locality (Forsyth, "Linear-Speed Vertex Cache Optimisation"),
+/// then vertices are renumbered in order of first use, and every Geometry / MorphTarget vector
+/// (including joints and weights) is permuted with the same remap. Unreferenced vertices are moved to the end.
+/// Indices keep their width. Accessors are not modified.
+///
+/// Throws Error if an index is out of range, or if the vertex vectors have mismatched sizes.
+///
+bool optimize(Mesh::Primitive& primitive);
+
+///
+/// \brief Parameters for welding.
+///
+struct Weld {
+	///
+	/// \brief Size of the grid to quantize float components to before comparing (0 to only merge identical vertices).
+	///
+	/// Vertices whose components all round to the same grid cell are merged.
+	///
+	float epsilon{};
+	///
+	/// \brief Number of threads to weld with (0 for hardware concurrency).
+	///
+	std::size_t threads{1};
+};
+
+///
+/// \brief Merge duplicate vertices of a Mesh Primitive.
+/// \param primitive Mesh Primitive whose Geometry (and MorphTargets) to weld
+/// \param weld Welding parameters
+/// \returns Number of vertices after welding
+///
+/// Vertices are compared across every Geometry vector (positions, normals, tangents, all tex_coords / colors,
+/// joints and weights) and every MorphTarget, so that merging never changes the rendered or morphed result.
+/// Duplicates are found via hashing (in parallel), and each set of duplicates is replaced by its first vertex:
+/// the output is identical regardless of the thread count. Vertices keep their relative order.
+/// Indices are remapped, keeping their width; unindexed primitives are given indices (u16 if they fit).
+/// Accessors are not modified.
+///
+/// Throws Error if an index is out of range, or if the vertex vectors have mismatched sizes.
+///
+std::size_t weld(Mesh::Primitive& primitive, Weld const& weld = {});
+} // namespace gltf2cpp
@@ -0,0 +1,182 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace gltf2cpp {
+///
+/// \brief Customization point describing a Vertex member as an array of arithmetic components.
+///
+/// Specializations must provide value_type, count_v, and data(Type&) (returning value_type*).
+/// Arithmetic types, std::array, and C arrays are supported out of the box; specialize this
+/// for other (layout-compatible) types, eg glm::vec3.
+///
+template <typename Type>
+struct VertexMember;
+
+template <typename Type>
+	requires(std::is_arithmetic_v<Type>)
+struct VertexMember<Type> {
+	using value_type = Type;
+	static constexpr std::size_t count_v{1};
+	static constexpr value_type* data(Type& t) { return &t; }
+};
+
+template <typename Type, std::size_t N>
+struct VertexMember<std::array<Type, N>> {
+	using value_type = Type;
+	static constexpr std::size_t count_v{N};
+	static constexpr value_type* data(std::array<Type, N>& t) { return t.data(); }
+};
+
+template <typename Type, std::size_t N>
+struct VertexMember<Type[N]> {
+	using value_type = Type;
+	static constexpr std::size_t count_v{N};
+	static constexpr value_type* data(Type (&t)[N]) { return t; }
+};
+
+///
+/// \brief Binding of a Vertex member to an Attribute semantic.
+///
+template <typename Vertex, typename Member>
+struct VertexField {
+	Member Vertex::*member{};
+	std::string_view semantic{};
+};
+
+template <typename Vertex, typename Member>
+VertexField(Member Vertex::*, std::string_view) -> VertexField<Vertex, Member>;
+
+///
+/// \brief Fill user defined Vertices directly from the Attributes of a Mesh Primitive.
+/// \param out Vertices to write to (must be at least as large as the Attributes' count)
+/// \param primitive Mesh Primitive whose Attributes to read
+/// \param accessors Accessors referenced by primitive (Root::accessors)
+/// \param fields (member pointer, semantic) pairs to fill
+/// \returns Number of vertices written
+///
+/// Conversion kernels are instantiated per ComponentType x Accessor::Type x member type, and
+/// dispatched once per field: the per-element loops contain no branches or variant visitation.
+/// Integer components are dequantized (as per Accessor::normalized) into floating point members,
+/// and copied as-is (saturated) into integral members. Floats are rounded into integral members.
+/// Missing components are written as 0, except for the fourth, which is written as 1 (eg alpha),
+/// or as the maximum value of an integral member if the source is normalized (as in interleave()).
+/// Members whose semantic is absent in primitive are left untouched.
+///
+/// Throws Error if the Attributes have mismatched counts, or out is too small.
+///
+template <typename Vertex, typename... Members>
+std::size_t extract_vertices(std::type_identity_t<std::span<Vertex>> out, Mesh::Primitive const& primitive, std::span<Accessor const> accessors,
+							 VertexField<Vertex, Members> const&... fields);
+
+// impl
+
+#define GLTF2CPP_EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace detail {
+///
+/// \brief Obtain the value representing 1 in a (normalized) component of type T.
+///
+template <typename T>
+constexpr T one(bool const normalized) {
+	if constexpr (std::is_integral_v<T>) {
+		if (normalized) { return std::numeric_limits<T>::max(); }
+	}
+	return T{1};
+}
+
+template <typename S, typename D, bool Normalized>
+constexpr D convert_component(S const value) {
+	if constexpr (std::is_floating_point_v<D>) {
+		if constexpr (Normalized && std::is_integral_v<S> && !std::is_same_v<S, std::uint32_t>) {
+			auto const ret = static_cast<D>(value) / static_cast<D>(std::numeric_limits<S>::max());
+			if constexpr (std::is_signed_v<S>) { return std::max(ret, D{-1}); }
+			return ret;
+		} else {
+			return static_cast<D>(value);
+		}
+	} else {
+		using Limits = std::numeric_limits<D>;
+		auto in = static_cast<double>(value);
+		if constexpr (std::is_floating_point_v<S>) { in = std::round(in); }
+		return static_cast<D>(std::clamp(in, static_cast<double>(Limits::lowest()), static_cast<double>(Limits::max())));
+	}
+}
+
+template <ComponentType C, std::size_t Dim, bool Normalized, typename Vertex, typename Member>
+void extract_kernel(std::span<Vertex> out, FromComponentType<C> const* src, std::size_t const count, Member Vertex::*member) {
+	using Traits = VertexMember<Member>;
+	using D = typename Traits::value_type;
+	constexpr auto present_v = std::min(Dim, Traits::count_v);
+	for (std::size_t i = 0; i < count; ++i, src += Dim) {
+		auto* dst = Traits::data(out[i].*member);
+		for (std::size_t c = 0; c < present_v; ++c) { dst[c] = convert_component<FromComponentType<C>, D, Normalized>(src[c]); }
+		for (std::size_t c = present_v; c < Traits::count_v; ++c) { dst[c] = c == 3 ? one<D>(Normalized) : D{}; }
+	}
+}
+
+template <ComponentType C, std::size_t Dim, typename Vertex, typename Member>
+void extract_field(std::span<Vertex> out, FromComponentType<C> const* src, Accessor const& accessor, Member Vertex::*member) {
+	if (accessor.normalized) {
+		extract_kernel<C, Dim, true>(out, src, accessor.count, member);
+	} else {
+		extract_kernel<C, Dim, false>(out, src, accessor.count, member);
+	}
+}
+
+template <ComponentType C, typename Vertex, typename Member>
+void extract_field(std::span<Vertex> out, Accessor const& accessor, Member Vertex::*member) {
+	auto const* data = std::get_if<Accessor::ComponentArray<C>>(&accessor.data());
+	GLTF2CPP_EXPECT(data && data->size() == accessor.count * Accessor::type_coeff(accessor.type));
+	auto const* src = data->data();
+	switch (accessor.type) {
+	case Accessor::Type::eScalar: extract_field<C, 1>(out, src, accessor, member); break;
+	case Accessor::Type::eVec2: extract_field<C, 2>(out, src, accessor, member); break;
+	case Accessor::Type::eVec3: extract_field<C, 3>(out, src, accessor, member); break;
+	case Accessor::Type::eVec4: extract_field<C, 4>(out, src, accessor, member); break;
+	default: GLTF2CPP_EXPECT(false && "Unsupported Attribute type"); break;
+	}
+}
+
+template <typename Vertex, typename Member>
+void extract_field(std::span<Vertex> out, Accessor const& accessor, Member Vertex::*member) {
+	switch (accessor.component_type) {
+	case ComponentType::eByte: extract_field<ComponentType::eByte>(out, accessor, member); break;
+	case ComponentType::eUnsignedByte: extract_field<ComponentType::eUnsignedByte>(out, accessor, member); break;
+	case ComponentType::eShort: extract_field<ComponentType::eShort>(out, accessor, member); break;
+	case ComponentType::eUnsignedShort: extract_field<ComponentType::eUnsignedShort>(out, accessor, member); break;
+	case ComponentType::eUnsignedInt: extract_field<ComponentType::eUnsignedInt>(out, accessor, member); break;
+	case ComponentType::eFloat: extract_field<ComponentType::eFloat>(out, accessor, member); break;
+	}
+}
+} // namespace detail
+
+template <typename Vertex, typename... Members>
+std::size_t extract_vertices(std::type_identity_t<std::span<Vertex>> out, Mesh::Primitive const& primitive, std::span<Accessor const> accessors,
+							 VertexField<Vertex, Members> const&... fields) {
+	auto count = std::optional<std::size_t>{};
+	auto const find = [&](std::string_view const semantic) -> Accessor const* {
+		auto const it = primitive.geometry.attributes.find(std::string{semantic});
+		if (it == primitive.geometry.attributes.end()) { return nullptr; }
+		GLTF2CPP_EXPECT(it->second < accessors.size());
+		auto const& ret = accessors[it->second];
+		if (!count) { count = ret.count; }
+		GLTF2CPP_EXPECT(ret.count == *count);
+		return &ret;
+	};
+	auto const sources = std::array<Accessor const*, sizeof...(Members)>{find(fields.semantic)...};
+	if (!count) { return 0; }
+	GLTF2CPP_EXPECT(out.size() >= *count);
+	auto index = std::size_t{};
+	auto const extract = [&](auto const& field) {
+		if (auto const* accessor = sources[index++]) { detail::extract_field(out, *accessor, field.member); }
+	};
+	(extract(fields), ...);
+	return *count;
+}
+
+#undef GLTF2CPP_EXPECT
+} // namespace gltf2cpp
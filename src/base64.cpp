@@ -0,0 +1,184 @@
+#include <detail/base64.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GLTF2CPP_BASE64_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define GLTF2CPP_TARGET(features)
+#else
+#define GLTF2CPP_TARGET(features) __attribute__((target(features)))
+#endif
+#endif
+
+namespace gltf2cpp {
+namespace {
+constexpr std::uint8_t invalid_v{0xff};
+
+constexpr std::array<std::uint8_t, 256> make_table() {
+	auto ret = std::array<std::uint8_t, 256>{};
+	for (auto& value : ret) { value = invalid_v; }
+	constexpr auto alphabet_v = std::string_view{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+	for (std::size_t i = 0; i < alphabet_v.size(); ++i) { ret[static_cast<std::uint8_t>(alphabet_v[i])] = static_cast<std::uint8_t>(i); }
+	return ret;
+}
+
+constexpr auto table_v = make_table();
+
+constexpr std::uint8_t lookup(char const ch) { return table_v[static_cast<std::uint8_t>(ch)]; }
+
+[[noreturn]] void malformed(char const* reason) {
+	auto err = std::string{"Malformed base64: "};
+	err += reason;
+	throw Error{detail::print_error(err.c_str())};
+}
+
+// decodes complete (unpadded) quanta in [in, in + length); returns false on invalid characters
+bool decode_scalar(char const* in, std::size_t length, std::byte* out) {
+	for (std::size_t i = 0; i < length; i += 4, out += 3) {
+		auto const a = lookup(in[i]);
+		auto const b = lookup(in[i + 1]);
+		auto const c = lookup(in[i + 2]);
+		auto const d = lookup(in[i + 3]);
+		// valid sextets never have the high bit set
+		if ((a | b | c | d) & 0x80) { return false; }
+		auto const triple = (std::uint32_t{a} << 18) | (std::uint32_t{b} << 12) | (std::uint32_t{c} << 6) | std::uint32_t{d};
+		out[0] = static_cast<std::byte>(triple >> 16);
+		out[1] = static_cast<std::byte>(triple >> 8);
+		out[2] = static_cast<std::byte>(triple);
+	}
+	return true;
+}
+
+#if defined(GLTF2CPP_BASE64_X86)
+// Vectorized decoding based on Muła / Lemire, "Faster Base64 Encoding and Decoding using AVX2 Instructions".
+// Each kernel stops at the first block containing a character outside the alphabet (including padding),
+// and returns the number of characters consumed; the scalar path takes over from there.
+// Stores are full width (16 / 32 bytes for 12 / 24 decoded), so out_length must leave room for them.
+
+GLTF2CPP_TARGET("ssse3,sse4.1")
+std::size_t decode_sse(char const* in, std::size_t length, std::byte* out, std::size_t out_length) {
+	auto const lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	auto const lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	auto const lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	auto const pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	auto const nibble = _mm_set1_epi8(0x0f);
+	auto const slash = _mm_set1_epi8(0x2f);
+	std::size_t i = 0, o = 0;
+	for (; i + 16 <= length && o + 16 <= out_length; i += 16, o += 12) {
+		auto str = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+		auto const hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), nibble);
+		auto const lo_nibbles = _mm_and_si128(str, nibble);
+		auto const hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+		auto const lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+		if (!_mm_testz_si128(lo, hi)) { break; }
+		auto const roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(str, slash), hi_nibbles));
+		str = _mm_add_epi8(str, roll);
+		auto const merged = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+		auto const packed = _mm_shuffle_epi8(_mm_madd_epi16(merged, _mm_set1_epi32(0x00011000)), pack);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), packed);
+	}
+	return i;
+}
+
+GLTF2CPP_TARGET("avx2")
+std::size_t decode_avx2(char const* in, std::size_t length, std::byte* out, std::size_t out_length) {
+	auto const lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11,
+										 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	auto const lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01,
+										 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	auto const lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	auto const pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	auto const lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+	auto const nibble = _mm256_set1_epi8(0x0f);
+	auto const slash = _mm256_set1_epi8(0x2f);
+	std::size_t i = 0, o = 0;
+	for (; i + 32 <= length && o + 32 <= out_length; i += 32, o += 24) {
+		auto str = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+		auto const hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), nibble);
+		auto const lo_nibbles = _mm256_and_si256(str, nibble);
+		auto const hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+		auto const lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+		if (!_mm256_testz_si256(lo, hi)) { break; }
+		auto const roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(str, slash), hi_nibbles));
+		str = _mm256_add_epi8(str, roll);
+		auto const merged = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+		auto const packed = _mm256_shuffle_epi8(_mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000)), pack);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + o), _mm256_permutevar8x32_epi32(packed, lanes));
+	}
+	return i;
+}
+
+struct Cpu {
+	bool sse4{};
+	bool avx2{};
+
+	static Cpu detect() {
+		auto ret = Cpu{};
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4]{};
+		__cpuid(info, 0);
+		auto const max_leaf = info[0];
+		__cpuid(info, 1);
+		ret.sse4 = (info[2] & (1 << 19)) != 0;
+		// AVX2 also requires OS support for saving YMM state
+		auto const osxsave = (info[2] & (1 << 27)) != 0;
+		if (max_leaf >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6) {
+			__cpuidex(info, 7, 0);
+			ret.avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		ret.sse4 = __builtin_cpu_supports("sse4.1");
+		ret.avx2 = __builtin_cpu_supports("avx2");
+#endif
+		return ret;
+	}
+};
+
+std::size_t decode_simd(char const* in, std::size_t length, std::byte* out, std::size_t out_length) {
+	static auto const cpu_v = Cpu::detect();
+	auto ret = std::size_t{};
+	if (cpu_v.avx2) { ret = decode_avx2(in, length, out, out_length); }
+	if (cpu_v.sse4) { ret += decode_sse(in + ret, length - ret, out + ret / 4 * 3, out_length - ret / 4 * 3); }
+	return ret;
+}
+#else
+std::size_t decode_simd(char const*, std::size_t, std::byte*, std::size_t) { return 0; }
+#endif
+} // namespace
+
+ByteArray detail::base64_decode(std::string_view const base64, Allocation allocation) {
+	if (base64.empty()) { return {}; }
+	if (base64.size() % 4 != 0) { malformed("length is not a multiple of 4"); }
+
+	auto const padding = base64.ends_with("==") ? 2u : (base64.ends_with('=') ? 1u : 0u);
+	auto const out_len = base64.size() / 4 * 3 - padding;
+	// every byte is written below
+	allocation.initialize = false;
+	auto ret = ByteArray{out_len, std::move(allocation)};
+
+	// all complete quanta (the last one is handled separately if it is padded)
+	auto const length = base64.size() - (padding > 0 ? 4 : 0);
+	auto const consumed = decode_simd(base64.data(), length, ret.data(), out_len);
+	if (!decode_scalar(base64.data() + consumed, length - consumed, ret.data() + consumed / 4 * 3)) { malformed("invalid character"); }
+
+	if (padding > 0) {
+		auto const* in = base64.data() + length;
+		auto const a = lookup(in[0]);
+		auto const b = lookup(in[1]);
+		auto const c = padding == 1 ? lookup(in[2]) : std::uint8_t{};
+		if ((a | b | c) & 0x80) { malformed("invalid character"); }
+		auto const triple = (std::uint32_t{a} << 18) | (std::uint32_t{b} << 12) | (std::uint32_t{c} << 6);
+		auto* out = ret.data() + length / 4 * 3;
+		out[0] = static_cast<std::byte>(triple >> 16);
+		if (padding == 1) { out[1] = static_cast<std::byte>(triple >> 8); }
+	}
+
+	return ret;
+}
+} // namespace gltf2cpp
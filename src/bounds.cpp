@@ -0,0 +1,145 @@
+#include <gltf2cpp/bounds.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/hierarchy.hpp>
+#include <algorithm>
+#include <cmath>
+
+// SSE2 is part of the x86-64 baseline; the reduction is bound by memory bandwidth, wider kernels are not worth a runtime dispatch.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLTF2CPP_BOUNDS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define GLTF2CPP_BOUNDS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+// Kernels reduce four points (three registers) per iteration and return the number of points consumed; the scalar loop takes over from there.
+// Lane j of the n-th register holds component (4n + j) % 3 of some point, so the registers are only folded into xyz at the end.
+void fold(float const (&lo)[12], float const (&hi)[12], Aabb& out) {
+	for (std::size_t j = 0; j < 12; ++j) {
+		out.min[j % 3] = std::min(out.min[j % 3], lo[j]);
+		out.max[j % 3] = std::max(out.max[j % 3], hi[j]);
+	}
+}
+
+#if defined(GLTF2CPP_BOUNDS_SSE2)
+std::size_t reduce_simd(float const* in, std::size_t const count, Aabb& out) {
+	if (count < 4) { return 0; }
+	__m128 lo[3]{_mm_loadu_ps(in), _mm_loadu_ps(in + 4), _mm_loadu_ps(in + 8)};
+	__m128 hi[3]{lo[0], lo[1], lo[2]};
+	std::size_t i = 4;
+	for (; i + 4 <= count; i += 4) {
+		for (std::size_t r = 0; r < 3; ++r) {
+			auto const v = _mm_loadu_ps(in + i * 3 + r * 4);
+			lo[r] = _mm_min_ps(lo[r], v);
+			hi[r] = _mm_max_ps(hi[r], v);
+		}
+	}
+	float lo_out[12]{};
+	float hi_out[12]{};
+	for (std::size_t r = 0; r < 3; ++r) {
+		_mm_storeu_ps(lo_out + r * 4, lo[r]);
+		_mm_storeu_ps(hi_out + r * 4, hi[r]);
+	}
+	fold(lo_out, hi_out, out);
+	return i;
+}
+#elif defined(GLTF2CPP_BOUNDS_NEON)
+std::size_t reduce_simd(float const* in, std::size_t const count, Aabb& out) {
+	if (count < 4) { return 0; }
+	float32x4_t lo[3]{vld1q_f32(in), vld1q_f32(in + 4), vld1q_f32(in + 8)};
+	float32x4_t hi[3]{lo[0], lo[1], lo[2]};
+	std::size_t i = 4;
+	for (; i + 4 <= count; i += 4) {
+		for (std::size_t r = 0; r < 3; ++r) {
+			auto const v = vld1q_f32(in + i * 3 + r * 4);
+			lo[r] = vminq_f32(lo[r], v);
+			hi[r] = vmaxq_f32(hi[r], v);
+		}
+	}
+	float lo_out[12]{};
+	float hi_out[12]{};
+	for (std::size_t r = 0; r < 3; ++r) {
+		vst1q_f32(lo_out + r * 4, lo[r]);
+		vst1q_f32(hi_out + r * 4, hi[r]);
+	}
+	fold(lo_out, hi_out, out);
+	return i;
+}
+#else
+std::size_t reduce_simd(float const*, std::size_t, Aabb&) { return 0; }
+#endif
+
+} // namespace
+
+Aabb compute_aabb(std::span<Vec<3> const> positions) {
+	auto ret = Aabb{};
+	if (positions.empty()) { return ret; }
+	auto i = reduce_simd(positions.front().data(), positions.size(), ret);
+	for (; i < positions.size(); ++i) { ret.merge(positions[i]); }
+	return ret;
+}
+
+Sphere bounding_sphere(Aabb const& aabb) {
+	if (aabb.empty()) { return {}; }
+	auto const extent = aabb.extent();
+	return Sphere{.center = aabb.center(), .radius = std::sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2])};
+}
+
+Aabb transform_aabb(Aabb const& aabb, Mat4x4 const& matrix) {
+	if (aabb.empty()) { return aabb; }
+	// transform the centre, and project the (rotated, scaled) extent onto each axis
+	auto const center = aabb.center();
+	auto const extent = aabb.extent();
+	auto ret = Aabb{};
+	for (std::size_t r = 0; r < 3; ++r) {
+		auto c = matrix[3][r];
+		auto e = 0.0f;
+		for (std::size_t k = 0; k < 3; ++k) {
+			c += matrix[k][r] * center[k];
+			e += std::abs(matrix[k][r]) * extent[k];
+		}
+		ret.min[r] = c - e;
+		ret.max[r] = c + e;
+	}
+	return ret;
+}
+
+WorldBounds world_bounds(Root const& root) {
+	auto ret = WorldBounds{.nodes = std::vector<Aabb>(root.nodes.size()), .scenes = std::vector<Aabb>(root.scenes.size())};
+	auto meshes = std::vector<Aabb>(root.meshes.size());
+	for (std::size_t i = 0; i < root.meshes.size(); ++i) {
+		for (auto const& primitive : root.meshes[i].primitives) { meshes[i].merge(primitive.aabb); }
+	}
+
+	auto const hierarchy = TransformHierarchy{root};
+	for (std::size_t entry = 0; entry < hierarchy.size(); ++entry) {
+		auto const& node = root.nodes[hierarchy.nodes()[entry]];
+		if (!node.mesh) { continue; }
+		EXPECT(*node.mesh < meshes.size());
+		ret.nodes[hierarchy.nodes()[entry]] = transform_aabb(meshes[*node.mesh], hierarchy.world_matrices()[entry]);
+	}
+
+	// a Node reachable more than once (malformed hierarchy) is only merged once
+	auto visited = std::vector<bool>(root.nodes.size());
+	auto stack = std::vector<Index<Node>>{};
+	for (std::size_t i = 0; i < root.scenes.size(); ++i) {
+		std::fill(visited.begin(), visited.end(), false);
+		stack.assign(root.scenes[i].root_nodes.begin(), root.scenes[i].root_nodes.end());
+		while (!stack.empty()) {
+			auto const index = stack.back();
+			stack.pop_back();
+			EXPECT(index < root.nodes.size());
+			if (visited[index]) { continue; }
+			visited[index] = true;
+			ret.scenes[i].merge(ret.nodes[index]);
+			stack.insert(stack.end(), root.nodes[index].children.begin(), root.nodes[index].children.end());
+		}
+	}
+	return ret;
+}
+} // namespace gltf2cpp
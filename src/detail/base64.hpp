@@ -0,0 +1,15 @@
+#pragma once
+#include <gltf2cpp/dyn_array.hpp>
+#include <string_view>
+
+namespace gltf2cpp::detail {
+///
+/// \brief Decode base64 text.
+/// \param base64 Text to decode (without any data URI prefix)
+/// \param allocation Memory resource and alignment to allocate decoded bytes with
+/// \returns Decoded bytes
+///
+/// Throws Error if base64 is malformed (invalid length, characters, or padding).
+///
+ByteArray base64_decode(std::string_view base64, Allocation allocation = {});
+} // namespace gltf2cpp::detail
@@ -0,0 +1,17 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+
+namespace gltf2cpp::detail {
+///
+/// \brief Obtain the size of a component in bytes.
+///
+constexpr std::size_t component_size(ComponentType const type) {
+	switch (type) {
+	case ComponentType::eByte:
+	case ComponentType::eUnsignedByte: return 1u;
+	case ComponentType::eShort:
+	case ComponentType::eUnsignedShort: return 2u;
+	default: return 4u;
+	}
+}
+} // namespace gltf2cpp::detail
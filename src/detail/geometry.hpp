@@ -0,0 +1,53 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+
+namespace gltf2cpp::detail {
+///
+/// \brief Obtain the number of vertices in a Mesh Primitive's Geometry.
+/// \returns Size of Geometry::positions
+///
+/// Throws Error if any other populated vertex vector (including MorphTargets, joints, and weights) has a different size.
+///
+std::size_t vertex_count(Mesh::Primitive const& primitive);
+
+///
+/// \brief Move every vertex of a Mesh Primitive (Geometry and MorphTargets) to a new index.
+/// \param primitive Mesh Primitive whose vertex vectors to permute
+/// \param remap New index of each vertex (all less than count)
+/// \param count Number of vertices after remapping
+///
+/// Where multiple vertices are mapped to the same index (eg welded duplicates), the first one is kept. Indices are not modified.
+///
+void remap_vertices(Mesh::Primitive& primitive, std::span<std::uint32_t const> remap, std::size_t count);
+
+///
+/// \brief Replace the vertices of a Mesh Primitive (Geometry and MorphTargets) with copies of existing ones.
+/// \param primitive Mesh Primitive whose vertex vectors to rebuild
+/// \param source Index of the existing vertex to copy into each new vertex
+///
+/// Indices are not modified.
+///
+void expand_vertices(Mesh::Primitive& primitive, std::span<std::uint32_t const> source);
+
+///
+/// \brief Store indices at the given width.
+/// \param indices Indices to store
+/// \param type ComponentType::eUnsignedShort or ComponentType::eUnsignedInt
+///
+Indices make_indices(std::vector<std::uint32_t> indices, ComponentType type);
+
+///
+/// \brief Obtain the list topology corresponding to a mode (eg eTriangles for eTriangleStrip).
+///
+PrimitiveMode list_mode(PrimitiveMode mode);
+
+///
+/// \brief Decode an index Accessor directly into list indices (see normalize_topology()).
+/// \param indices Index Accessor (unsigned)
+/// \param mode Topology of indices
+/// \returns List indices (of list_mode(mode)), u8 is widened to u16
+///
+/// Fuses index decoding / widening and topology conversion into a single pass.
+///
+Indices list_indices(Accessor const& indices, PrimitiveMode mode);
+} // namespace gltf2cpp::detail
@@ -0,0 +1,76 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gltf2cpp::detail {
+///
+/// \brief Obtain the number of threads to use.
+/// \param requested Requested number of threads (0 for hardware concurrency)
+/// \returns Number of threads to use (at least 1)
+///
+inline std::size_t thread_count(std::size_t requested) {
+	if (requested == 0) { requested = std::thread::hardware_concurrency(); }
+	return std::max(requested, std::size_t{1});
+}
+
+///
+/// \brief Invoke func(index) for each index in [0, count), distributed across threads.
+/// \param count Number of indices
+/// \param threads Maximum number of threads to use (0 for hardware concurrency)
+/// \param func Callable to invoke for each index
+///
+/// func must only write to state owned by the index it is passed.
+/// The calling thread participates; the first exception thrown is rethrown on it after all workers have joined.
+///
+template <typename F>
+void parallel_for(std::size_t count, std::size_t threads, F&& func) {
+	threads = std::min(thread_count(threads), count);
+	if (threads <= 1) {
+		for (std::size_t i = 0; i < count; ++i) { func(i); }
+		return;
+	}
+	auto next = std::atomic<std::size_t>{};
+	auto error = std::exception_ptr{};
+	auto mutex = std::mutex{};
+	auto work = [&] {
+		for (auto i = next++; i < count; i = next++) {
+			try {
+				func(i);
+			} catch (...) {
+				auto lock = std::scoped_lock{mutex};
+				if (!error) { error = std::current_exception(); }
+				next = count;
+			}
+		}
+	};
+	auto workers = std::vector<std::thread>{};
+	workers.reserve(threads - 1);
+	for (std::size_t i = 0; i + 1 < threads; ++i) { workers.emplace_back(work); }
+	work();
+	for (auto& worker : workers) { worker.join(); }
+	if (error) { std::rethrow_exception(error); }
+}
+
+///
+/// \brief Invoke func(index) for each index in [0, count), distributed across threads in chunks.
+/// \param count Number of indices
+/// \param threads Maximum number of threads to use (0 for hardware concurrency)
+/// \param chunk_size Number of consecutive indices per task
+/// \param func Callable to invoke for each index
+///
+/// For fine grained work (eg per vertex), where a task per index would be dominated by scheduling.
+///
+template <typename F>
+void parallel_chunks(std::size_t count, std::size_t threads, std::size_t chunk_size, F&& func) {
+	auto const chunks = (count + chunk_size - 1) / chunk_size;
+	parallel_for(chunks, threads, [&](std::size_t const chunk) {
+		auto const last = std::min((chunk + 1) * chunk_size, count);
+		for (auto i = chunk * chunk_size; i < last; ++i) { func(i); }
+	});
+}
+} // namespace gltf2cpp::detail
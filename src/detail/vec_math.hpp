@@ -0,0 +1,31 @@
+#pragma once
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace gltf2cpp::detail {
+constexpr Vec<3> add(Vec<3> const& a, Vec<3> const& b) { return {a[0] + b[0], a[1] + b[1], a[2] + b[2]}; }
+constexpr Vec<3> sub(Vec<3> const& a, Vec<3> const& b) { return {a[0] - b[0], a[1] - b[1], a[2] - b[2]}; }
+constexpr Vec<3> scale(Vec<3> const& v, float const s) { return {v[0] * s, v[1] * s, v[2] * s}; }
+constexpr float dot(Vec<3> const& a, Vec<3> const& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+constexpr Vec<3> cross(Vec<3> const& a, Vec<3> const& b) { return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]}; }
+inline float length(Vec<3> const& v) { return std::sqrt(dot(v, v)); }
+
+///
+/// \brief Normalize a vector.
+/// \returns Zero vector if v is (nearly) zero
+///
+inline Vec<3> normalize(Vec<3> const& v) {
+	auto const len = length(v);
+	return len > 1e-20f ? scale(v, 1.0f / len) : Vec<3>{};
+}
+
+///
+/// \brief Obtain the angle between two (not necessarily normalized) vectors.
+///
+inline float angle(Vec<3> const& a, Vec<3> const& b) {
+	auto const len = length(a) * length(b);
+	if (len <= 0.0f) { return 0.0f; }
+	return std::acos(std::clamp(dot(a, b) / len, -1.0f, 1.0f));
+}
+} // namespace gltf2cpp::detail
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace gltf2cpp::detail {
+///
+/// \brief Zero-extend unsigned integers to a wider type.
+/// \param in Source integers
+/// \param out Destination (must be at least as large as in)
+///
+/// Vectorized with SSE2 / NEON where available.
+///
+void widen(std::span<std::uint16_t const> in, std::span<std::uint32_t> out);
+void widen(std::span<std::uint8_t const> in, std::span<std::uint32_t> out);
+void widen(std::span<std::uint8_t const> in, std::span<std::uint16_t> out);
+} // namespace gltf2cpp::detail
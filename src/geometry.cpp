@@ -0,0 +1,68 @@
+#include <detail/geometry.hpp>
+#include <gltf2cpp/error.hpp>
+#include <type_traits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+template <typename Primitive, typename F>
+void for_each_vector(Primitive& primitive, F func) {
+	auto const visit_vertices = [&func](auto& geometry) {
+		func(geometry.positions);
+		func(geometry.normals);
+		func(geometry.tangents);
+		for (auto& v : geometry.tex_coords) { func(v); }
+		for (auto& v : geometry.colors) { func(v); }
+	};
+	visit_vertices(primitive.geometry);
+	for (auto& v : primitive.geometry.joints) { func(v); }
+	for (auto& v : primitive.geometry.weights) { func(v); }
+	for (auto& target : primitive.targets) { visit_vertices(target); }
+}
+
+template <typename T>
+void remap_vector(std::vector<T>& out, std::span<std::uint32_t const> remap, std::size_t const count) {
+	if (out.empty()) { return; }
+	auto ret = std::vector<T>(count);
+	// in reverse, so that the first vertex mapped to each index is kept
+	for (auto i = remap.size(); i-- > 0;) { ret[remap[i]] = out[i]; }
+	out = std::move(ret);
+}
+} // namespace
+
+std::size_t detail::vertex_count(Mesh::Primitive const& primitive) {
+	auto const ret = primitive.geometry.positions.size();
+	for_each_vector(primitive, [ret](auto const& v) { EXPECT(v.empty() || v.size() == ret); });
+	return ret;
+}
+
+void detail::remap_vertices(Mesh::Primitive& primitive, std::span<std::uint32_t const> remap, std::size_t const count) {
+	for_each_vector(primitive, [remap, count](auto& v) {
+		EXPECT(v.empty() || v.size() == remap.size());
+		remap_vector(v, remap, count);
+	});
+}
+
+void detail::expand_vertices(Mesh::Primitive& primitive, std::span<std::uint32_t const> source) {
+	for_each_vector(primitive, [source](auto& v) {
+		if (v.empty()) { return; }
+		auto ret = std::remove_cvref_t<decltype(v)>(source.size());
+		for (std::size_t i = 0; i < source.size(); ++i) {
+			EXPECT(source[i] < v.size());
+			ret[i] = v[source[i]];
+		}
+		v = std::move(ret);
+	});
+}
+
+Indices detail::make_indices(std::vector<std::uint32_t> indices, ComponentType const type) {
+	if (type != ComponentType::eUnsignedShort) { return Indices{std::move(indices)}; }
+	auto ret = std::vector<std::uint16_t>(indices.size());
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		EXPECT(indices[i] <= 0xffff);
+		ret[i] = static_cast<std::uint16_t>(indices[i]);
+	}
+	return Indices{std::move(ret)};
+}
+} // namespace gltf2cpp
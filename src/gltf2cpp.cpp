@@ -1,54 +1,84 @@
+#include <detail/base64.hpp>
+#include <detail/component.hpp>
+#include <detail/geometry.hpp>
+#include <detail/parallel.hpp>
+#include <detail/widen.hpp>
+#include <gltf2cpp/bounds.hpp>
 #include <gltf2cpp/error.hpp>
 #include <gltf2cpp/gltf2cpp.hpp>
+#include <gltf2cpp/process.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <limits>
+#include <mutex>
+#include <type_traits>
 
 namespace gltf2cpp {
 #define EXPECT(expr) detail::expect(!!(expr), #expr)
 
 namespace fs = std::filesystem;
 
+struct detail::AccessorStorage {
+	std::once_flag once{};
+	std::atomic<bool> decoded{};
+	ByteArray source{};
+	Accessor::Data data{};
+	ParseOptions::Bounds bounds{ParseOptions::Bounds::eClamp};
+	Allocation allocation{};
+	bool out_of_bounds{};
+};
+
 namespace {
 struct Reader {
 	fs::path prefix{};
 	std::unordered_map<std::string, ByteArray> loaded{};
-
-	std::span<std::byte const> operator()(std::string const& uri) {
-		if (auto it = loaded.find(uri); it != loaded.end()) { return it->second.span(); }
-		auto file = std::ifstream{prefix / uri, std::ios::binary | std::ios::ate};
-		if (!file) { return {}; }
-		auto const size = file.tellg();
-		auto [it, _] = loaded.insert_or_assign(uri, ByteArray{static_cast<std::size_t>(size)});
-		file.seekg({}, std::ios::beg);
-		file.read(reinterpret_cast<char*>(it->second.data()), size);
-		return it->second.span();
+	std::mutex mutex{};
+
+	ByteArray operator()(std::string const& uri) {
+		auto lock = std::scoped_lock{mutex};
+		if (auto it = loaded.find(uri); it != loaded.end()) { return it->second.share(); }
+		auto bytes = map_file((prefix / uri).string().c_str());
+		if (!bytes) { return {}; }
+		auto [it, _] = loaded.insert_or_assign(uri, std::move(bytes));
+		return it->second.share();
 	}
 };
 
+namespace glb {
+constexpr std::uint32_t magic_v{0x46546C67};
+constexpr std::uint32_t version_v{2};
+constexpr std::uint32_t chunk_json_v{0x4E4F534A};
+constexpr std::uint32_t chunk_bin_v{0x004E4942};
+constexpr std::size_t header_size_v{12};
+constexpr std::size_t chunk_header_size_v{8};
+
+std::uint32_t read_u32(std::span<std::byte const> bytes, std::size_t offset) {
+	auto ret = std::uint32_t{};
+	std::memcpy(&ret, bytes.data() + offset, sizeof(ret));
+	return ret;
+}
+} // namespace glb
+
+// dequantizes an Accessor min / max value exactly as normalize_components() does the data
 template <typename T>
-struct Limit {
-	T data[16];
-	std::size_t size{};
+float normalize_limit(double const value) {
+	auto const ret = static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+	if constexpr (std::is_signed_v<T>) { return std::max(ret, -1.0f); }
+	return ret;
+}
 
-	constexpr void push_back(T t) {
-		EXPECT(size < std::size(data));
-		data[size++] = t;
+float dequantize_limit(double const value, ComponentType const type, bool const normalized) {
+	if (!normalized) { return static_cast<float>(value); }
+	switch (type) {
+	case ComponentType::eByte: return normalize_limit<std::int8_t>(value);
+	case ComponentType::eUnsignedByte: return normalize_limit<std::uint8_t>(value);
+	case ComponentType::eShort: return normalize_limit<std::int16_t>(value);
+	case ComponentType::eUnsignedShort: return normalize_limit<std::uint16_t>(value);
+	default: return static_cast<float>(value);
 	}
-
-	constexpr std::span<T const> span() const { return {data, size}; }
-};
-
-struct AccessorLayout {
-	dj::Json const& min{};
-	dj::Json const& max{};
-	std::size_t count{};
-	std::size_t component_coeff{};
-	std::optional<std::size_t> stride{};
-
-	constexpr std::size_t container_size() const { return count * component_coeff; }
-};
+}
 
 constexpr auto identity_matrix_v = Mat4x4{{
 	Vec<4>{{1.0f, 0.0f, 0.0f, 0.0f}},
@@ -64,133 +94,258 @@ constexpr std::size_t get_base64_start(std::string_view str) {
 	return it + match_v.size();
 }
 
-ByteArray to_byte_array(std::span<std::byte const> in) {
-	auto ret = ByteArray{in.size()};
-	std::memcpy(ret.data(), in.data(), ret.size());
+constexpr AlphaMode get_alpha_mode(std::string_view const mode) {
+	if (mode == "MASK") {
+		return AlphaMode::eMask;
+	} else if (mode == "BLEND") {
+		return AlphaMode::eBlend;
+	}
+	return AlphaMode::eOpaque;
+}
+
+AttributeMap make_attributes(dj::Json const& json) {
+	auto ret = AttributeMap{};
+	for (auto [key, value] : json.object_view()) { ret.insert_or_assign(std::string{key}, value.as<Index<Accessor>>()); }
 	return ret;
 }
 
-ByteArray base64_decode(std::string_view const base64) {
-	static constexpr std::uint8_t table[] = {
-		64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-		64, 64, 64, 64, 64, 64, 62, 64, 64, 64, 63, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 64, 64, 64, 64, 64, 64, 64, 0,	1,	2,	3,	4,	5,	6,	7,	8,
-		9,	10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 64, 64, 64, 64, 64, 64, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
-		40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-		64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-		64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-		64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-	};
+template <std::size_t Dim>
+Vec<Dim> get_vec(dj::Json const& value, Vec<Dim> const& fallback = {}) {
+	auto ret = fallback;
+	if (!value) { return ret; }
+	EXPECT(value.array_view().size() >= Dim);
+	for (std::size_t i = 0; i < Dim; ++i) { ret[i] = value[i].as<float>(); }
+	return ret;
+}
 
-	std::size_t const in_len = base64.size();
-	EXPECT(in_len % 4 == 0);
-	if (in_len % 4 != 0) { return {}; }
+std::vector<double> get_limit(dj::Json const& value) {
+	auto ret = std::vector<double>{};
+	ret.reserve(value.array_view().size());
+	for (auto const& element : value.array_view()) { ret.push_back(element.as<double>()); }
+	return ret;
+}
 
-	auto out_len = in_len / 4 * 3;
-	if (base64[in_len - 1] == '=') { out_len--; }
-	if (base64[in_len - 2] == '=') { out_len--; }
+template <typename T>
+constexpr T narrow_limit(double const value) {
+	using Limits = std::numeric_limits<T>;
+	return static_cast<T>(std::clamp(value, static_cast<double>(Limits::lowest()), static_cast<double>(Limits::max())));
+}
 
-	auto ret = ByteArray{out_len};
+// Dequantization kernels: straight-line loops over contiguous components (int -> float convert, scale, clamp),
+// which compilers vectorize. Normalization follows the GLTF spec: c / max for unsigned, max(c / max, -1) for signed.
+template <typename T>
+void convert_components(std::span<T const> in, std::span<float> out) {
+	for (std::size_t i = 0; i < in.size(); ++i) { out[i] = static_cast<float>(in[i]); }
+}
 
-	for (std::uint32_t i = 0, j = 0; i < in_len;) {
-		std::uint32_t const a = base64[i] == '=' ? 0 & i++ : table[static_cast<std::size_t>(base64[i++])];
-		std::uint32_t const b = base64[i] == '=' ? 0 & i++ : table[static_cast<std::size_t>(base64[i++])];
-		std::uint32_t const c = base64[i] == '=' ? 0 & i++ : table[static_cast<std::size_t>(base64[i++])];
-		std::uint32_t const d = base64[i] == '=' ? 0 & i++ : table[static_cast<std::size_t>(base64[i++])];
+template <typename T>
+void normalize_components(std::span<T const> in, std::span<float> out) {
+	static constexpr auto max_v = static_cast<float>(std::numeric_limits<T>::max());
+	if constexpr (std::is_signed_v<T>) {
+		for (std::size_t i = 0; i < in.size(); ++i) { out[i] = std::max(static_cast<float>(in[i]) / max_v, -1.0f); }
+	} else {
+		for (std::size_t i = 0; i < in.size(); ++i) { out[i] = static_cast<float>(in[i]) / max_v; }
+	}
+}
 
-		std::uint32_t const triple = (a << 3 * 6) + (b << 2 * 6) + (c << 1 * 6) + (d << 0 * 6);
+// Bounds kernels are specialized per component type and width (component_coeff).
+// min / max are pre-expanded to a block of block_v components (a whole number of elements),
+// so that the inner loops have a fixed trip count and no modulo, and can be vectorized.
+template <typename T, std::size_t Width>
+struct BoundsKernel {
+	static constexpr std::size_t block_v{Width * 16};
+
+	std::array<T, block_v> min{};
+	std::array<T, block_v> max{};
+
+	BoundsKernel(std::span<double const> lo, std::span<double const> hi) {
+		EXPECT(lo.empty() || lo.size() == Width);
+		EXPECT(hi.empty() || hi.size() == Width);
+		for (std::size_t j = 0; j < block_v; ++j) {
+			min[j] = lo.empty() ? std::numeric_limits<T>::lowest() : narrow_limit<T>(lo[j % Width]);
+			max[j] = hi.empty() ? std::numeric_limits<T>::max() : narrow_limit<T>(hi[j % Width]);
+		}
+	}
 
-		if (j < out_len) { ret[j++] = static_cast<std::byte>((triple >> 2 * 8) & 0xFF); }
-		if (j < out_len) { ret[j++] = static_cast<std::byte>((triple >> 1 * 8) & 0xFF); }
-		if (j < out_len) { ret[j++] = static_cast<std::byte>((triple >> 0 * 8) & 0xFF); }
+	bool exceeds(std::span<T const> data) const {
+		auto i = std::size_t{};
+		for (; i + block_v <= data.size(); i += block_v) {
+			auto const* block = data.data() + i;
+			auto ret = false;
+			for (std::size_t j = 0; j < block_v; ++j) { ret |= (block[j] < min[j]) | (block[j] > max[j]); }
+			if (ret) { return true; }
+		}
+		for (std::size_t j = 0; i < data.size(); ++i, ++j) {
+			if (data[i] < min[j] || data[i] > max[j]) { return true; }
+		}
+		return false;
+	}
+
+	void clamp(std::span<T> data) const {
+		auto i = std::size_t{};
+		for (; i + block_v <= data.size(); i += block_v) {
+			auto* block = data.data() + i;
+			for (std::size_t j = 0; j < block_v; ++j) { block[j] = std::min(std::max(block[j], min[j]), max[j]); }
+		}
+		for (std::size_t j = 0; i < data.size(); ++i, ++j) { data[i] = std::min(std::max(data[i], min[j]), max[j]); }
 	}
+};
 
+template <typename T, typename F>
+void visit_bounds_kernel(AccessorLayout const& layout, F func) {
+	if (layout.min.empty() && layout.max.empty()) { return; }
+	switch (layout.component_coeff) {
+	case 1: func(BoundsKernel<T, 1>{layout.min, layout.max}); break;
+	case 2: func(BoundsKernel<T, 2>{layout.min, layout.max}); break;
+	case 3: func(BoundsKernel<T, 3>{layout.min, layout.max}); break;
+	case 4: func(BoundsKernel<T, 4>{layout.min, layout.max}); break;
+	case 9: func(BoundsKernel<T, 9>{layout.min, layout.max}); break;
+	case 16: func(BoundsKernel<T, 16>{layout.min, layout.max}); break;
+	default: EXPECT(false && "Invalid component_coeff");
+	}
+}
+
+template <typename T>
+bool exceeds_bounds(std::span<T const> data, AccessorLayout const& layout) {
+	auto ret = false;
+	visit_bounds_kernel<T>(layout, [&](auto const& kernel) { ret = kernel.exceeds(data); });
 	return ret;
 }
 
-constexpr AlphaMode get_alpha_mode(std::string_view const mode) {
-	if (mode == "MASK") {
-		return AlphaMode::eMask;
-	} else if (mode == "BLEND") {
-		return AlphaMode::eBlend;
+template <typename T>
+void clamp_to_bounds(std::span<T> data, AccessorLayout const& layout) {
+	visit_bounds_kernel<T>(layout, [&](auto const& kernel) { kernel.clamp(data); });
+}
+
+struct DecodeInfo {
+	ParseOptions::Bounds bounds{};
+	Accessor::Sparse const* sparse{};
+	Allocation allocation{};
+	bool out_of_bounds{};
+};
+
+template <typename T>
+void apply_sparse(std::span<T> out, Accessor::Sparse const& sparse, std::size_t component_coeff) {
+	auto const* values = std::get_if<DynArray<T>>(&sparse.values);
+	EXPECT(values && values->size() == sparse.indices.size() * component_coeff);
+	auto const source = values->span();
+	for (std::size_t i = 0; i < sparse.indices.size(); ++i) {
+		auto const index = sparse.indices[i];
+		EXPECT((index + 1) * component_coeff <= out.size());
+		std::memcpy(out.data() + index * component_coeff, source.data() + i * component_coeff, component_coeff * sizeof(T));
 	}
-	return AlphaMode::eOpaque;
 }
 
-AttributeMap make_attributes(dj::Json const& json) {
-	auto ret = AttributeMap{};
-	for (auto [key, value] : json.object_view()) { ret.insert_or_assign(std::string{key}, value.as<Index<Accessor>>()); }
-	return ret;
+// De-interleave kernels: copy count elements of Width bytes, stride bytes apart, into a packed array.
+// The element width is a compile time constant, so the per-element copy is a fixed size load / store
+// instead of a memcpy call. Widths cover every ComponentType x Accessor::Type combination.
+using Deinterleave = void (*)(std::byte* out, std::byte const* in, std::size_t count, std::size_t stride, std::size_t width);
+
+template <std::size_t Width>
+void deinterleave_kernel(std::byte* out, std::byte const* in, std::size_t const count, std::size_t const stride, std::size_t /*width*/) {
+	for (std::size_t i = 0; i < count; ++i, in += stride, out += Width) { std::memcpy(out, in, Width); }
 }
 
-enum class Bound { eFloor, eCeil };
+void deinterleave_any(std::byte* out, std::byte const* in, std::size_t const count, std::size_t const stride, std::size_t const width) {
+	for (std::size_t i = 0; i < count; ++i, in += stride, out += width) { std::memcpy(out, in, width); }
+}
 
-template <Bound B, typename T>
-constexpr void limit(std::span<T> out, std::span<T const> range) {
-	if (range.empty()) { return; }
-	EXPECT(out.size() % range.size() == 0);
-	for (std::size_t i = 0; i < out.size(); ++i) {
-		auto const j = i % range.size();
-		if constexpr (B == Bound::eFloor) {
-			out[i] = std::max(out[i], static_cast<T>(range[j]));
-		} else {
-			out[i] = std::min(out[i], static_cast<T>(range[j]));
-		}
+constexpr Deinterleave select_deinterleave(std::size_t const width) {
+	switch (width) {
+	case 1: return &deinterleave_kernel<1>;
+	case 2: return &deinterleave_kernel<2>;
+	case 3: return &deinterleave_kernel<3>;
+	case 4: return &deinterleave_kernel<4>;
+	case 6: return &deinterleave_kernel<6>;
+	case 8: return &deinterleave_kernel<8>;
+	case 9: return &deinterleave_kernel<9>;
+	case 12: return &deinterleave_kernel<12>;
+	case 16: return &deinterleave_kernel<16>;
+	case 18: return &deinterleave_kernel<18>;
+	case 32: return &deinterleave_kernel<32>;
+	case 36: return &deinterleave_kernel<36>;
+	case 64: return &deinterleave_kernel<64>;
+	default: return &deinterleave_any;
 	}
 }
 
-template <std::size_t Dim>
-Vec<Dim> get_vec(dj::Json const& value, Vec<Dim> const& fallback = {}) {
-	auto ret = fallback;
-	if (!value) { return ret; }
-	EXPECT(value.array_view().size() >= Dim);
-	for (std::size_t i = 0; i < Dim; ++i) { ret[i] = value[i].as<float>(); }
-	return ret;
+void check_source(std::span<std::byte const> source, std::size_t const count, std::size_t const stride, std::size_t const element_width) {
+	if (source.empty() || count == 0) { return; }
+	EXPECT(stride >= element_width);
+	EXPECT(source.size() >= (count - 1) * stride + element_width);
 }
 
-template <Bound B, typename T>
-constexpr void apply_limit(std::span<T> out, dj::Json::ArrayProxy const& source, std::size_t width) {
-	EXPECT(source.size() == width);
-	auto range = Limit<T>{};
-	for (auto const& element : source) { range.push_back(element.as<T>()); }
-	limit<B>(out, range.span());
+template <typename T>
+DynArray<T> finish_component_data(DynArray<T> arr, AccessorLayout const& layout, DecodeInfo& info) {
+	using Bounds = ParseOptions::Bounds;
+	// min / max apply to the data after sparse substitution
+	if (info.sparse) { apply_sparse(arr.span(), *info.sparse, layout.component_coeff); }
+	if (info.bounds != Bounds::eSkip && !info.out_of_bounds) { info.out_of_bounds = exceeds_bounds<T>(arr.span(), layout); }
+	if (info.bounds == Bounds::eClamp && info.out_of_bounds) { clamp_to_bounds(arr.span(), layout); }
+	arr.debug_refresh();
+	return arr;
 }
 
 template <ComponentType C>
-auto make_component_data(std::span<std::byte const> span, AccessorLayout layout) {
+auto make_component_data(ByteArray const& bytes, AccessorLayout const& layout, DecodeInfo& info) {
 	using T = FromComponentType<C>;
-	auto arr = DynArray<T>{layout.container_size()};
+	using Bounds = ParseOptions::Bounds;
+	auto const span = std::span<std::byte const>{bytes.span()};
+	auto const element_width = sizeof(T) * layout.component_coeff;
+	auto const stride = layout.stride.value_or(element_width);
+	check_source(span, layout.count, stride, element_width);
+	if (!span.empty() && layout.count > 0) {
+		// tightly packed and aligned: view the source bytes directly (if no patching / clamping is required)
+		auto const aligned = reinterpret_cast<std::uintptr_t>(span.data()) % alignof(T) == 0;
+		if (stride == element_width && aligned && !info.sparse) {
+			auto ret = bytes.template reinterpret<T>(0u, layout.container_size());
+			if (info.bounds != Bounds::eSkip) { info.out_of_bounds = exceeds_bounds<T>(ret.span(), layout); }
+			if (info.bounds != Bounds::eClamp || !info.out_of_bounds) { return ret; }
+		}
+	}
+	// uninitialized unless there is no source data: it is fully overwritten below
+	auto allocation = info.allocation;
+	allocation.initialize = span.empty();
+	auto arr = DynArray<T>{layout.container_size(), std::move(allocation)};
 	if (!span.empty()) {
-		auto const size_bytes = layout.container_size() * sizeof(T);
-		auto const element_width = sizeof(T) * layout.component_coeff;
-		EXPECT(span.size() * layout.stride.value_or(1) >= size_bytes);
-		auto const stride = layout.stride.value_or(element_width);
-		EXPECT(stride >= element_width);
+		auto* out = reinterpret_cast<std::byte*>(arr.data());
 		if (element_width < stride) {
-			for (std::size_t i = 0; i < layout.count; ++i) {
-				auto& t = arr.span()[i * layout.component_coeff];
-				std::memcpy(&t, span.data(), sizeof(T) * layout.component_coeff);
-				span = span.subspan(*layout.stride);
-			}
+			select_deinterleave(element_width)(out, span.data(), layout.count, stride, element_width);
 		} else {
-			std::memcpy(arr.data(), span.data(), size_bytes);
+			std::memcpy(out, span.data(), layout.container_size() * sizeof(T));
 		}
 	}
-	if (layout.min) { apply_limit<Bound::eFloor>(arr.span(), layout.min.array_view(), layout.component_coeff); }
-	if (layout.max) { apply_limit<Bound::eCeil>(arr.span(), layout.max.array_view(), layout.component_coeff); }
-	arr.debug_refresh();
-	return arr;
+	return finish_component_data(std::move(arr), layout, info);
 }
 
-Accessor::Data make_accessor_data(std::span<std::byte const> bytes, ComponentType ctype, AccessorLayout layout) {
+// Accessors sharing a strided BufferView are de-interleaved in blocks of elements, each Accessor in turn,
+// so that a block of source bytes stays in cache: one pass over the BufferView instead of one per Accessor.
+constexpr std::size_t deinterleave_block_v{256};
+
+// Allocates uninitialized storage for an Accessor, to be filled by the caller.
+Accessor::Data allocate_accessor_data(ComponentType const ctype, std::size_t const size, Allocation allocation) {
+	allocation.initialize = false;
+	switch (ctype) {
+	case ComponentType::eByte: return Accessor::Byte{size, std::move(allocation)};
+	case ComponentType::eShort: return Accessor::Short{size, std::move(allocation)};
+	case ComponentType::eUnsignedShort: return Accessor::UnsignedShort{size, std::move(allocation)};
+	case ComponentType::eUnsignedInt: return Accessor::UnsignedInt{size, std::move(allocation)};
+	case ComponentType::eFloat: return Accessor::Float{size, std::move(allocation)};
+	default:
+	case ComponentType::eUnsignedByte: return Accessor::UnsignedByte{size, std::move(allocation)};
+	}
+}
+
+Accessor::Data make_accessor_data(ByteArray const& bytes, ComponentType ctype, AccessorLayout const& layout, DecodeInfo& info) {
 	auto ret = Accessor::Data{};
 	switch (ctype) {
-	case ComponentType::eByte: ret = make_component_data<ComponentType::eByte>(bytes, layout); break;
-	case ComponentType::eShort: ret = make_component_data<ComponentType::eShort>(bytes, layout); break;
-	case ComponentType::eUnsignedShort: ret = make_component_data<ComponentType::eUnsignedShort>(bytes, layout); break;
-	case ComponentType::eUnsignedInt: ret = make_component_data<ComponentType::eUnsignedInt>(bytes, layout); break;
-	case ComponentType::eFloat: ret = make_component_data<ComponentType::eFloat>(bytes, layout); break;
+	case ComponentType::eByte: ret = make_component_data<ComponentType::eByte>(bytes, layout, info); break;
+	case ComponentType::eShort: ret = make_component_data<ComponentType::eShort>(bytes, layout, info); break;
+	case ComponentType::eUnsignedShort: ret = make_component_data<ComponentType::eUnsignedShort>(bytes, layout, info); break;
+	case ComponentType::eUnsignedInt: ret = make_component_data<ComponentType::eUnsignedInt>(bytes, layout, info); break;
+	case ComponentType::eFloat: ret = make_component_data<ComponentType::eFloat>(bytes, layout, info); break;
 	default:
-	case ComponentType::eUnsignedByte: ret = make_component_data<ComponentType::eUnsignedByte>(bytes, layout); break;
+	case ComponentType::eUnsignedByte: ret = make_component_data<ComponentType::eUnsignedByte>(bytes, layout, info); break;
 	}
 	return ret;
 }
@@ -216,7 +371,6 @@ Transform get_transform(dj::Json const& node) {
 }
 
 std::vector<Vec<3>> to_rgbs(gltf2cpp::Accessor const& accessor) {
-	EXPECT(accessor.component_type == gltf2cpp::ComponentType::eFloat); // facade restriction
 	if (accessor.type == gltf2cpp::Accessor::Type::eVec3) { return accessor.to_vec<3>(); }
 	auto const vec4 = accessor.to_vec<4>(); // spec
 	auto ret = std::vector<Vec<3>>{};
@@ -234,23 +388,231 @@ std::vector<UVec<4>> to_joints(gltf2cpp::Accessor const& accessor) {
 	return ret;
 }
 
-std::vector<Vec<4>> to_weights(gltf2cpp::Accessor const& accessor) {
-	if (accessor.component_type == gltf2cpp::ComponentType::eFloat) { return accessor.to_vec<4>(); }
-	return {};
+std::vector<Vec<4>> to_weights(gltf2cpp::Accessor const& accessor) { return accessor.to_vec<4>(); }
+
+template <typename T>
+std::size_t vector_bytes(std::vector<T> const& vec) {
+	return vec.capacity() * sizeof(T);
+}
+
+std::size_t vector_bytes(Indices const& indices) {
+	return std::visit([](auto const& v) { return vector_bytes(v); }, indices.storage());
+}
+
+template <typename T>
+std::size_t vector_bytes(std::vector<std::vector<T>> const& vec) {
+	auto ret = vec.capacity() * sizeof(std::vector<T>);
+	for (auto const& v : vec) { ret += vector_bytes(v); }
+	return ret;
+}
+
+template <typename T>
+std::size_t geometry_bytes(T const& geometry) {
+	auto ret = vector_bytes(geometry.positions) + vector_bytes(geometry.normals) + vector_bytes(geometry.tangents);
+	ret += vector_bytes(geometry.tex_coords) + vector_bytes(geometry.colors);
+	if constexpr (std::is_same_v<T, Geometry>) { ret += vector_bytes(geometry.indices) + vector_bytes(geometry.joints) + vector_bytes(geometry.weights); }
+	return ret;
+}
+
+// Entries of each (decode heavy) category to parse.
+struct Selection {
+	std::vector<bool> buffers{};
+	std::vector<bool> accessors{};
+	std::vector<bool> images{};
+	std::vector<bool> meshes{};
+	std::vector<bool> animations{};
+	std::vector<bool> skins{};
+
+	static void mark(std::vector<bool>& out, dj::Json const& index) {
+		if (index.is_number() && index.as<std::size_t>() < out.size()) { out[index.as<std::size_t>()] = true; }
+	}
+
+	static void mark_textures(std::vector<bool>& out, dj::Json const& json) {
+		for (auto [key, value] : json.object_view()) {
+			if (std::string_view{key}.ends_with("Texture")) { mark(out, value["index"]); }
+			mark_textures(out, value);
+		}
+	}
+
+	static Selection make(dj::Json const& json, ParseOptions::Select const& select) {
+		auto const make_mask = [&json](std::string_view const key, bool const value) { return std::vector<bool>(json[key].array_view().size(), value); };
+		auto ret = Selection{};
+		if (select.all()) {
+			for (auto [out, key] : {std::pair{&ret.buffers, "buffers"}, {&ret.accessors, "accessors"}, {&ret.images, "images"}, {&ret.meshes, "meshes"},
+									{&ret.animations, "animations"}, {&ret.skins, "skins"}}) {
+				*out = make_mask(key, true);
+			}
+			return ret;
+		}
+
+		auto reached_meshes = make_mask("meshes", !select.scene);
+		ret.skins = make_mask("skins", select.skins && !select.scene);
+		ret.animations = make_mask("animations", select.animations && !select.scene);
+		if (select.scene) {
+			auto const& nodes = json["nodes"].array_view();
+			auto visited = std::vector<bool>(nodes.size());
+			auto stack = std::vector<std::size_t>{};
+			for (auto const& node : json["scenes"][*select.scene]["nodes"].array_view()) { stack.push_back(node.as<std::size_t>()); }
+			while (!stack.empty()) {
+				auto const index = stack.back();
+				stack.pop_back();
+				if (index >= visited.size() || visited[index]) { continue; }
+				visited[index] = true;
+				auto const& node = nodes[index];
+				mark(reached_meshes, node["mesh"]);
+				if (select.skins) { mark(ret.skins, node["skin"]); }
+				for (auto const& child : node["children"].array_view()) { stack.push_back(child.as<std::size_t>()); }
+			}
+			auto const targets_visited = [&visited](dj::Json const& animation) {
+				return std::ranges::any_of(animation["channels"].array_view(), [&visited](dj::Json const& channel) {
+					auto const& node = channel["target"]["node"];
+					return node.is_number() && node.as<std::size_t>() < visited.size() && visited[node.as<std::size_t>()];
+				});
+			};
+			auto index = std::size_t{};
+			for (auto const& animation : json["animations"].array_view()) { ret.animations[index++] = select.animations && targets_visited(animation); }
+		}
+		ret.meshes = select.meshes ? reached_meshes : make_mask("meshes", false);
+
+		ret.images = make_mask("images", select.images && !select.scene);
+		if (select.images && select.scene) {
+			auto materials = make_mask("materials", false);
+			auto index = std::size_t{};
+			for (auto const& mesh : json["meshes"].array_view()) {
+				if (!reached_meshes[index++]) { continue; }
+				for (auto const& primitive : mesh["primitives"].array_view()) { mark(materials, primitive["material"]); }
+			}
+			auto textures = make_mask("textures", false);
+			index = 0;
+			for (auto const& material : json["materials"].array_view()) {
+				if (materials[index++]) { mark_textures(textures, material); }
+			}
+			index = 0;
+			for (auto const& texture : json["textures"].array_view()) {
+				if (!textures[index++]) { continue; }
+				mark(ret.images, texture["source"]);
+				// image sources of extensions (eg KHR_texture_basisu)
+				for (auto [_, extension] : texture["extensions"].object_view()) { mark(ret.images, extension["source"]); }
+			}
+		}
+
+		ret.accessors = make_mask("accessors", false);
+		auto const mark_attributes = [&ret](dj::Json const& attributes) {
+			for (auto [_, accessor] : attributes.object_view()) { mark(ret.accessors, accessor); }
+		};
+		auto index = std::size_t{};
+		for (auto const& mesh : json["meshes"].array_view()) {
+			if (!ret.meshes[index++]) { continue; }
+			for (auto const& primitive : mesh["primitives"].array_view()) {
+				mark(ret.accessors, primitive["indices"]);
+				mark_attributes(primitive["attributes"]);
+				for (auto const& target : primitive["targets"].array_view()) { mark_attributes(target); }
+			}
+		}
+		index = 0;
+		for (auto const& skin : json["skins"].array_view()) {
+			if (ret.skins[index++]) { mark(ret.accessors, skin["inverseBindMatrices"]); }
+		}
+		index = 0;
+		for (auto const& animation : json["animations"].array_view()) {
+			if (!ret.animations[index++]) { continue; }
+			for (auto const& sampler : animation["samplers"].array_view()) {
+				mark(ret.accessors, sampler["input"]);
+				mark(ret.accessors, sampler["output"]);
+			}
+		}
+
+		auto const& buffer_views = json["bufferViews"].array_view();
+		ret.buffers = make_mask("buffers", false);
+		auto const mark_buffer = [&](dj::Json const& buffer_view) {
+			if (buffer_view.is_number() && buffer_view.as<std::size_t>() < buffer_views.size()) { mark(ret.buffers, buffer_views[buffer_view.as<std::size_t>()]["buffer"]); }
+		};
+		index = 0;
+		for (auto const& accessor : json["accessors"].array_view()) {
+			if (!ret.accessors[index++]) { continue; }
+			mark_buffer(accessor["bufferView"]);
+			mark_buffer(accessor["sparse"]["indices"]["bufferView"]);
+			mark_buffer(accessor["sparse"]["values"]["bufferView"]);
+		}
+		index = 0;
+		for (auto const& image : json["images"].array_view()) {
+			if (ret.images[index++]) { mark_buffer(image["bufferView"]); }
+		}
+		return ret;
+	}
+};
+
+// Accessors used by animations / skins: these must outlive Mesh Primitives.
+std::vector<bool> pinned_accessors(dj::Json const& scene) {
+	auto ret = std::vector<bool>(scene["accessors"].array_view().size());
+	for (auto const& animation : scene["animations"].array_view()) {
+		for (auto const& sampler : animation["samplers"].array_view()) {
+			Selection::mark(ret, sampler["input"]);
+			Selection::mark(ret, sampler["output"]);
+		}
+	}
+	for (auto const& skin : scene["skins"].array_view()) { Selection::mark(ret, skin["inverseBindMatrices"]); }
+	return ret;
+}
+
+// Accessors referenced by a Mesh Primitive (sorted, unique).
+std::vector<Index<Accessor>> primitive_accessors(dj::Json const& primitive) {
+	auto ret = std::vector<Index<Accessor>>{};
+	auto const add = [&ret](dj::Json const& index) {
+		if (index.is_number()) { ret.push_back(index.as<std::size_t>()); }
+	};
+	auto const add_attributes = [&add](dj::Json const& attributes) {
+		for (auto [_, index] : attributes.object_view()) { add(index); }
+	};
+	add(primitive["indices"]);
+	add_attributes(primitive["attributes"]);
+	for (auto const& target : primitive["targets"].array_view()) { add_attributes(target); }
+	std::ranges::sort(ret);
+	auto const [first, last] = std::ranges::unique(ret);
+	ret.erase(first, last);
+	return ret;
 }
 
 struct GltfParser {
-	GetBytes const& get_bytes;
+	LoadBytes const& load_bytes;
+	ByteArray const& bin;
+	ParseOptions const& options;
 	Root& root;
+	// threads for the stages in process(): primitives are already processed in parallel unless there is only one
+	std::size_t stage_threads{1};
 
-	void buffer(dj::Json const& json) {
-		auto& b = root.buffers.emplace_back();
+	Allocation allocation() const { return {.resource = options.resource, .alignment = options.alignment}; }
+
+	ByteArray view_bytes(BufferView const& view) const {
+		auto const span = view.to_span(root.buffers);
+		if (span.empty()) { return {}; }
+		return root.buffers[view.buffer].bytes.share(view.offset, span.size());
+	}
+
+	template <typename T>
+	void fan_out(std::vector<T>& out, dj::Json const& json, void (GltfParser::*func)(dj::Json const&, std::size_t), std::vector<bool> const& selected) {
+		auto elements = std::vector<dj::Json const*>{};
+		for (auto const& element : json.array_view()) { elements.push_back(&element); }
+		out.resize(elements.size());
+		detail::parallel_for(elements.size(), options.threads, [&](std::size_t index) {
+			// unselected entries are left as placeholders
+			if (selected[index]) { (this->*func)(*elements[index], index); }
+		});
+	}
+
+	void buffer(dj::Json const& json, Index<Buffer> index) {
+		auto& b = root.buffers[index];
 		auto const uri = json["uri"].as_string();
-		EXPECT(!uri.empty());
-		if (auto i = get_base64_start(uri); i != std::string_view::npos) {
-			b.bytes = base64_decode(uri.substr(i));
-		} else if (get_bytes) {
-			b.bytes = ByteArray{get_bytes(uri)};
+		if (uri.empty()) {
+			// GLB-stored buffer: must be the first one, and may be smaller than the (padded) BIN chunk
+			EXPECT(index == 0 && !bin.empty());
+			auto const length = json["byteLength"].as<std::size_t>(bin.size());
+			EXPECT(length <= bin.size());
+			b.bytes = bin.share(0u, length);
+		} else if (auto i = get_base64_start(uri); i != std::string_view::npos) {
+			b.bytes = detail::base64_decode(uri.substr(i), allocation());
+		} else if (load_bytes) {
+			b.bytes = load_bytes(uri);
 		}
 	}
 
@@ -264,34 +626,127 @@ struct GltfParser {
 		if (auto const& stride = json["byteStride"]) { bv.stride = stride.as<std::size_t>(); }
 	}
 
-	void accessor(dj::Json const& json) {
-		auto& a = root.accessors.emplace_back();
+	void accessor(dj::Json const& json, Index<Accessor> index) {
+		auto& a = root.accessors[index];
 		EXPECT(json.contains("componentType") && json.contains("count") && json.contains("type"));
 		a.component_type = static_cast<ComponentType>(json["componentType"].as<int>());
 		a.type = Accessor::to_type(json["type"].as_string());
 		a.name = json["name"].as_string(a.name);
 		a.normalized = json["normalized"].as_bool(dj::Boolean{false}).value;
 		a.count = json["count"].as<std::size_t>();
-		auto bytes = std::span<std::byte const>{};
+		a.storage = std::make_shared<detail::AccessorStorage>();
+		a.storage->bounds = options.bounds;
+		a.storage->allocation = allocation();
 		auto stride = std::optional<std::size_t>{};
 		a.byte_offset = json["byteOffset"].as<std::size_t>(0);
 		if (auto const& bv = json["bufferView"]) {
 			a.buffer_view = bv.as<std::size_t>();
-			auto const& view = root.buffer_views[*a.buffer_view];
-			bytes = view.to_span(root.buffers).subspan(a.byte_offset);
-			stride = view.stride;
+			a.storage->source = accessor_bytes(*a.buffer_view, a.byte_offset);
+			stride = root.buffer_views[*a.buffer_view].stride;
 		}
+		if (auto const& sparse = json["sparse"]) { a.sparse = accessor_sparse(sparse, a); }
 		a.extensions = json["extensions"];
 		a.extras = json["extras"];
 
-		auto const layout = AccessorLayout{
-			.min = json["min"],
-			.max = json["max"],
+		a.layout = AccessorLayout{
+			.min = get_limit(json["min"]),
+			.max = get_limit(json["max"]),
 			.count = a.count,
 			.component_coeff = Accessor::type_coeff(a.type),
 			.stride = stride,
 		};
-		a.data = make_accessor_data(bytes, a.component_type, layout);
+		// sparse accessors are only densified on demand, interleaved ones are decoded per BufferView (deinterleave_views())
+		if (options.accessors == ParseOptions::Decode::eEager && !a.sparse && !interleaved(a)) { a.data(); }
+	}
+
+	static bool interleaved(Accessor const& a) {
+		if (!a.buffer_view || !a.layout.stride || a.sparse || a.count == 0 || a.storage->source.empty()) { return false; }
+		return *a.layout.stride > detail::component_size(a.component_type) * a.layout.component_coeff;
+	}
+
+	void deinterleave_views() {
+		auto groups = std::vector<std::vector<Index<Accessor>>>(root.buffer_views.size());
+		for (std::size_t i = 0; i < root.accessors.size(); ++i) {
+			auto const& a = root.accessors[i];
+			if (a.storage && !a.decoded() && interleaved(a)) { groups[*a.buffer_view].push_back(i); }
+		}
+		std::erase_if(groups, [](auto const& group) { return group.empty(); });
+		detail::parallel_for(groups.size(), options.threads, [&](std::size_t i) { deinterleave_view(groups[i]); });
+	}
+
+	void deinterleave_view(std::span<Index<Accessor> const> group) {
+		struct Target {
+			Accessor* accessor{};
+			Accessor::Data data{};
+			Deinterleave func{};
+			std::byte const* source{};
+			std::byte* out{};
+			std::size_t width{};
+		};
+		auto const stride = *root.buffer_views[*root.accessors[group.front()].buffer_view].stride;
+		auto targets = std::vector<Target>{};
+		targets.reserve(group.size());
+		auto count = std::size_t{};
+		for (auto const index : group) {
+			auto& a = root.accessors[index];
+			auto& t = targets.emplace_back(Target{.accessor = &a, .width = detail::component_size(a.component_type) * a.layout.component_coeff});
+			check_source(a.storage->source.span(), a.count, stride, t.width);
+			t.data = allocate_accessor_data(a.component_type, a.layout.container_size(), a.storage->allocation);
+			t.func = select_deinterleave(t.width);
+			t.source = a.storage->source.data();
+			t.out = std::visit([](auto& arr) { return reinterpret_cast<std::byte*>(arr.data()); }, t.data);
+			count = std::max(count, a.count);
+		}
+		for (std::size_t first = 0; first < count; first += deinterleave_block_v) {
+			for (auto const& t : targets) {
+				if (first >= t.accessor->count) { continue; }
+				auto const block = std::min(deinterleave_block_v, t.accessor->count - first);
+				t.func(t.out + first * t.width, t.source + first * stride, block, stride, t.width);
+			}
+		}
+		for (auto& t : targets) {
+			auto& storage = *t.accessor->storage;
+			std::call_once(storage.once, [&] {
+				auto info = DecodeInfo{.bounds = storage.bounds};
+				std::visit([&](auto& arr) { storage.data = finish_component_data(std::move(arr), t.accessor->layout, info); }, t.data);
+				storage.out_of_bounds = info.out_of_bounds;
+				storage.source = {};
+				storage.decoded = true;
+			});
+		}
+	}
+
+	ByteArray accessor_bytes(Index<BufferView> buffer_view, std::size_t byte_offset) const {
+		auto const source = view_bytes(root.buffer_views.at(buffer_view));
+		EXPECT(byte_offset <= source.size());
+		return source.share(byte_offset, source.size() - byte_offset);
+	}
+
+	Accessor::Sparse accessor_sparse(dj::Json const& json, Accessor const& accessor) const {
+		EXPECT(json.contains("count") && json.contains("indices") && json.contains("values"));
+		auto ret = Accessor::Sparse{};
+		auto const count = json["count"].as<std::size_t>();
+		ret.extensions = json["extensions"];
+		ret.extras = json["extras"];
+		auto info = DecodeInfo{.bounds = ParseOptions::Bounds::eSkip, .allocation = allocation()};
+
+		auto const& indices = json["indices"];
+		EXPECT(indices.contains("bufferView") && indices.contains("componentType"));
+		auto const index_type = static_cast<ComponentType>(indices["componentType"].as<int>());
+		auto const index_bytes = accessor_bytes(indices["bufferView"].as<std::size_t>(), indices["byteOffset"].as<std::size_t>(0));
+		auto const index_data = make_accessor_data(index_bytes, index_type, AccessorLayout{.count = count, .component_coeff = 1}, info);
+		EXPECT(!std::holds_alternative<Accessor::Byte>(index_data) && !std::holds_alternative<Accessor::Short>(index_data));
+		EXPECT(!std::holds_alternative<Accessor::Float>(index_data));
+		ret.indices.reserve(count);
+		std::visit([&ret](auto const& d) { ret.indices.insert(ret.indices.end(), d.span().begin(), d.span().end()); }, index_data);
+		EXPECT(std::ranges::all_of(ret.indices, [&accessor](std::uint32_t i) { return i < accessor.count; }));
+
+		auto const& values = json["values"];
+		EXPECT(values.contains("bufferView"));
+		auto const value_bytes = accessor_bytes(values["bufferView"].as<std::size_t>(), values["byteOffset"].as<std::size_t>(0));
+		auto const value_layout = AccessorLayout{.count = count, .component_coeff = Accessor::type_coeff(accessor.type)};
+		ret.values = make_accessor_data(value_bytes, accessor.component_type, value_layout, info);
+		return ret;
 	}
 
 	Camera::Orthographic orthographic(dj::Json const& json) const {
@@ -358,28 +813,25 @@ struct GltfParser {
 		out.positions = root.accessors[it_pos->second].template to_vec<3>();
 		if (auto it_norm = attributes.find("NORMAL"); it_norm != attributes.end()) { out.normals = root.accessors[it_norm->second].template to_vec<3>(); }
 		if (auto it_tan = attributes.find("TANGENT"); it_tan != attributes.end()) {
-			// some sample files use vec3 tangents
+			// some sample files use vec3 tangents: assume right handed (w = 1); morph target tangents are vec3 displacements (w = 0)
+			static constexpr auto w_v = std::is_same_v<T, Geometry> ? 1.0f : 0.0f;
 			auto const& accessor = root.accessors[it_tan->second];
 			if (accessor.type == Accessor::Type::eVec4) {
 				out.tangents = accessor.template to_vec<4>();
 			} else if (accessor.type == Accessor::Type::eVec3) {
 				auto vec = accessor.template to_vec<3>();
 				out.tangents.reserve(vec.size());
-				for (auto const& v : vec) { out.tangents.push_back({v[0], v[1], v[2], 0.0f}); }
+				for (auto const& v : vec) { out.tangents.push_back({v[0], v[1], v[2], w_v}); }
 			}
 		}
 		auto populate_rgb = [&](Accessor const& accessor) {
-			if (accessor.component_type == ComponentType::eFloat) {
-				out.colors.push_back(to_rgbs(accessor));
-				EXPECT(out.colors.back().size() == out.positions.size());
-			}
+			out.colors.push_back(to_rgbs(accessor));
+			EXPECT(out.colors.back().size() == out.positions.size());
 		};
 		populate_indexed(attributes, "COLOR_", populate_rgb);
 		auto populate_uv = [&](Accessor const& accessor) {
-			if (accessor.component_type == ComponentType::eFloat) {
-				out.tex_coords.push_back(accessor.template to_vec<2>());
-				EXPECT(out.tex_coords.back().size() == out.positions.size());
-			}
+			out.tex_coords.push_back(accessor.template to_vec<2>());
+			EXPECT(out.tex_coords.back().size() == out.positions.size());
 		};
 		populate_indexed(attributes, "TEXCOORD_", populate_uv);
 	}
@@ -393,51 +845,154 @@ struct GltfParser {
 		ret.geometry.attributes = make_attributes(json["attributes"]);
 		if (auto const& indices = json["indices"]) {
 			ret.indices = indices.as<std::size_t>();
-			ret.geometry.indices = root.accessors[*ret.indices].to_u32();
+			if (options.keep.geometry) { ret.geometry.indices = decode_indices(root.accessors[*ret.indices], ret.mode); }
 		}
 		if (auto const& material = json["material"]) { ret.material = material.as<std::size_t>(); }
-		populate(ret.geometry);
 		for (auto const& target : json["targets"].array_view()) {
 			auto& morph_target = ret.targets.emplace_back();
 			morph_target.attributes = make_attributes(target);
-			populate(morph_target);
 		}
+		if (!options.keep.geometry) {
+			bound(ret);
+			return ret;
+		}
+		populate(ret.geometry);
+		for (auto& morph_target : ret.targets) { populate(morph_target); }
 		auto populate_joint = [&](Accessor const& accessor) { ret.geometry.joints.push_back(to_joints(accessor)); };
 		populate_indexed(ret.geometry.attributes, "JOINTS_", populate_joint);
 		auto populate_weight = [&](Accessor const& accessor) { ret.geometry.weights.push_back(to_weights(accessor)); };
 		populate_indexed(ret.geometry.attributes, "WEIGHTS_", populate_weight);
 		EXPECT(ret.geometry.joints.size() == ret.geometry.weights.size());
+		process(ret);
+		bound(ret);
+		return ret;
+	}
+
+	// min / max is required for POSITION: positions are only scanned if it is absent or exceeded (and not clamped)
+	void bound(Mesh::Primitive& out) const {
+		if (auto const aabb = declared_aabb(out.geometry.attributes)) {
+			out.aabb = *aabb;
+		} else {
+			out.aabb = compute_aabb(out.geometry.positions);
+		}
+		out.sphere = bounding_sphere(out.aabb);
+	}
+
+	std::optional<Aabb> declared_aabb(AttributeMap const& attributes) const {
+		auto const it = attributes.find("POSITION");
+		if (it == attributes.end()) { return {}; }
+		auto const& accessor = root.accessors[it->second];
+		auto const& layout = accessor.layout;
+		if (layout.min.size() != 3 || layout.max.size() != 3) { return {}; }
+		// data is only clamped to min / max with eClamp
+		if (options.bounds == ParseOptions::Bounds::eValidate && accessor.out_of_bounds()) { return {}; }
+		auto ret = Aabb{};
+		for (std::size_t i = 0; i < 3; ++i) {
+			ret.min[i] = dequantize_limit(layout.min[i], accessor.component_type, accessor.normalized);
+			ret.max[i] = dequantize_limit(layout.max[i], accessor.component_type, accessor.normalized);
+		}
+		if (ret.empty()) { return {}; }
+		return ret;
+	}
+
+	Indices decode_indices(Accessor const& accessor, PrimitiveMode& mode) const {
+		if (!options.process.normalize_topology) { return accessor.to_indices(); }
+		auto ret = detail::list_indices(accessor, mode);
+		mode = detail::list_mode(mode);
 		return ret;
 	}
 
-	void mesh(dj::Json const& json) {
+	void process(Mesh::Primitive& out) const {
+		// indexed primitives have already been converted in decode_indices()
+		if (options.process.normalize_topology) { normalize_topology(out); }
+		if (options.process.weld) { weld(out, Weld{.epsilon = options.process.weld_epsilon, .threads = stage_threads}); }
+		if (options.process.normals && out.geometry.normals.empty()) {
+			auto const mode = options.process.crease_angle > 0.0f ? Normals::Mode::eSmooth : Normals::Mode::eFlat;
+			generate_normals(out, Normals{.mode = mode, .crease_angle = options.process.crease_angle, .threads = stage_threads});
+		}
+		if (options.process.tangents && out.geometry.tangents.empty()) { generate_tangents(out, Tangents{.threads = stage_threads}); }
+		if (options.process.optimize) { optimize(out); }
+	}
+
+	void mesh(dj::Json const& json, Index<Mesh> index) {
 		auto const& primitives = json["primitives"].array_view();
 		EXPECT(!primitives.empty());
-		auto& m = root.meshes.emplace_back();
+		auto& m = root.meshes[index];
 		m.name = json["name"].as_string(m.name);
 		m.extensions = json["extensions"];
 		m.extras = json["extras"];
-		for (auto const& j : primitives) { m.primitives.push_back(primitive(j)); }
+		m.primitives.resize(primitives.size());
 		for (auto const& j : json["weights"].array_view()) { m.weights.push_back(j.as<float>()); }
-		[[maybe_unused]] auto const target_count = m.primitives[0].targets.size();
-		EXPECT(std::ranges::all_of(m.primitives, [target_count](auto const& p) { return p.targets.size() == target_count; }));
 	}
 
-	void image(dj::Json const& json) {
-		auto& i = root.images.emplace_back();
+	void meshes(dj::Json const& scene, std::vector<bool> const& selected) {
+		auto const& json = scene["meshes"];
+		fan_out(root.meshes, json, &GltfParser::mesh, selected);
+		// primitives are independent of each other: populate them all in one batch
+		struct Entry {
+			dj::Json const* json{};
+			Index<Mesh> mesh{};
+			std::size_t index{};
+			Mesh::Primitive* out{};
+		};
+		auto entries = std::vector<Entry>{};
+		auto index = std::size_t{};
+		for (auto const& mesh : json.array_view()) {
+			if (!selected[index]) {
+				++index;
+				continue;
+			}
+			auto const& primitives = mesh["primitives"].array_view();
+			[[maybe_unused]] auto const target_count = primitives[0]["targets"].array_view().size();
+			EXPECT(std::ranges::all_of(primitives, [target_count](dj::Json const& p) { return p["targets"].array_view().size() == target_count; }));
+			auto& m = root.meshes[index];
+			auto primitive_index = std::size_t{};
+			for (auto const& p : primitives) {
+				entries.push_back({&p, index, primitive_index, &m.primitives[primitive_index]});
+				++primitive_index;
+			}
+			++index;
+		}
+		stage_threads = entries.size() == 1 ? options.threads : 1;
+		if (!options.visitor.on_primitive) {
+			detail::parallel_for(entries.size(), options.threads, [&](std::size_t i) { *entries[i].out = primitive(*entries[i].json); });
+			return;
+		}
+		// streaming: hand each primitive over, then release accessors once all their primitives have been visited
+		auto const pinned = pinned_accessors(scene);
+		auto uses = std::vector<std::atomic<std::size_t>>(root.accessors.size());
+		for (auto const& entry : entries) {
+			for (auto const accessor : primitive_accessors(*entry.json)) { ++uses[accessor]; }
+		}
+		detail::parallel_for(entries.size(), options.threads, [&](std::size_t i) {
+			auto& entry = entries[i];
+			auto out = primitive(*entry.json);
+			options.visitor.on_primitive(entry.mesh, entry.index, out, root.accessors);
+			for (auto const accessor : primitive_accessors(*entry.json)) {
+				if (--uses[accessor] == 0 && !pinned[accessor]) { root.accessors[accessor].storage.reset(); }
+			}
+		});
+	}
+
+	void image(dj::Json const& json, Index<Image> index) {
+		auto& i = root.images[index];
 		auto name = json["name"].as<std::string>();
 		i.extensions = json["extensions"];
 		i.extras = json["extras"];
 		EXPECT(json.contains("uri") || json.contains("bufferView"));
 		if (auto const uri = json["uri"].as_string(); !uri.empty()) {
 			if (auto const it = get_base64_start(uri); it != std::string_view::npos) {
-				i = Image{base64_decode(uri.substr(it)), std::move(name)};
-			} else if (get_bytes) {
-				i = Image{ByteArray{get_bytes(uri)}, std::move(name), std::string{uri}};
+				i = Image{detail::base64_decode(uri.substr(it), allocation()), std::move(name)};
+			} else if (load_bytes) {
+				i = Image{load_bytes(uri), std::move(name), std::string{uri}};
 			}
 		} else {
 			auto const& bv = root.buffer_views[json["bufferView"].as<std::size_t>()];
-			i = Image{to_byte_array(bv.to_span(root.buffers)), std::move(name)};
+			i = Image{view_bytes(bv), std::move(name)};
+		}
+		if (options.visitor.on_image) {
+			options.visitor.on_image(index, i);
+			i = {};
 		}
 	}
 
@@ -511,7 +1066,7 @@ struct GltfParser {
 		ret.extensions = json["extensions"];
 		ret.extras = json["extras"];
 		EXPECT(json.contains("input") && json.contains("output"));
-		ret.input = std::get<Accessor::Float>(root.accessors.at(json["input"].as<std::size_t>()).data).span();
+		ret.input = std::get<Accessor::Float>(root.accessors.at(json["input"].as<std::size_t>()).data()).span();
 		ret.output = json["output"].as<std::size_t>();
 		auto const& interpolation = json["interpolation"].as_string();
 		if (interpolation == "STEP") {
@@ -556,17 +1111,21 @@ struct GltfParser {
 		return ret;
 	}
 
-	void animation(dj::Json const& json) {
-		auto& a = root.animations.emplace_back();
+	void animation(dj::Json const& json, Index<Animation> index) {
+		auto& a = root.animations[index];
 		a.name = json["name"].as_string(a.name);
 		a.extensions = json["extensions"];
 		a.extras = json["extras"];
 		for (auto const& sampler : json["samplers"].array_view()) { a.samplers.push_back(anim_sampler(sampler)); }
 		for (auto const& channel : json["channels"].array_view()) { a.channels.push_back(anim_channel(channel)); }
+		if (options.visitor.on_animation) {
+			options.visitor.on_animation(index, a, root.accessors);
+			a = {};
+		}
 	}
 
-	void skin(dj::Json const& json) {
-		auto& s = root.skins.emplace_back();
+	void skin(dj::Json const& json, Index<Skin> index) {
+		auto& s = root.skins[index];
 		s.name = json["name"].as_string(s.name);
 		s.extensions = json["extensions"];
 		s.extras = json["extras"];
@@ -582,18 +1141,21 @@ struct GltfParser {
 	void parse(dj::Json const& scene) {
 		root = {};
 
-		for (auto const& b : scene["buffers"].array_view()) { buffer(b); }
+		auto const selection = Selection::make(scene, options.select);
+
+		fan_out(root.buffers, scene["buffers"], &GltfParser::buffer, selection.buffers);
 		for (auto const& bv : scene["bufferViews"].array_view()) { buffer_view(bv); }
 
-		for (auto const& s : scene["accessors"].array_view()) { accessor(s); }
+		fan_out(root.accessors, scene["accessors"], &GltfParser::accessor, selection.accessors);
+		if (options.accessors == ParseOptions::Decode::eEager) { deinterleave_views(); }
 		for (auto const& c : scene["cameras"].array_view()) { camera(c); }
 		for (auto const& s : scene["samplers"].array_view()) { sampler(s); }
-		for (auto const& i : scene["images"].array_view()) { image(i); }
+		fan_out(root.images, scene["images"], &GltfParser::image, selection.images);
 		for (auto const& t : scene["textures"].array_view()) { texture(t); }
-		for (auto const& m : scene["meshes"].array_view()) { mesh(m); }
+		meshes(scene, selection.meshes);
 		for (auto const& m : scene["materials"].array_view()) { material(m); }
-		for (auto const& a : scene["animations"].array_view()) { animation(a); }
-		for (auto const& a : scene["skins"].array_view()) { skin(a); }
+		fan_out(root.animations, scene["animations"], &GltfParser::animation, selection.animations);
+		fan_out(root.skins, scene["skins"], &GltfParser::skin, selection.skins);
 
 		// Texture will use ColourSpace::sRGB by default; change non-colour textures to be linear
 		auto set_linear = [this](std::size_t index) { root.textures[index].linear = true; };
@@ -607,6 +1169,36 @@ struct GltfParser {
 			if (m.occlusion_texture) { set_linear(m.occlusion_texture->info.texture); }
 			if (m.normal_texture) { set_linear(m.normal_texture->info.texture); }
 		}
+
+		release(scene);
+	}
+
+	void release(dj::Json const& scene) {
+		if (!options.keep.accessors) {
+			// release accessors covered by Geometry / MorphTarget, unless also used by animations / skins
+			auto covered = std::vector<bool>(root.accessors.size());
+			auto const cover = [&](Accessor const& accessor) { covered[static_cast<std::size_t>(&accessor - root.accessors.data())] = true; };
+			auto const cover_attributes = [&](AttributeMap const& attributes) {
+				for (auto const semantic : {"POSITION", "NORMAL", "TANGENT"}) {
+					if (auto const it = attributes.find(semantic); it != attributes.end()) { cover(root.accessors[it->second]); }
+				}
+				for (auto const prefix : {"TEXCOORD_", "COLOR_", "JOINTS_", "WEIGHTS_"}) { populate_indexed(attributes, prefix, cover); }
+			};
+			for (auto const& mesh : root.meshes) {
+				for (auto const& primitive : mesh.primitives) {
+					if (primitive.indices) { cover(root.accessors[*primitive.indices]); }
+					cover_attributes(primitive.geometry.attributes);
+					for (auto const& target : primitive.targets) { cover_attributes(target.attributes); }
+				}
+			}
+			auto const pinned = pinned_accessors(scene);
+			for (std::size_t i = 0; i < covered.size(); ++i) {
+				if (covered[i] && !pinned[i]) { root.accessors[i].storage.reset(); }
+			}
+		}
+		if (!options.keep.buffers) {
+			for (auto& buffer : root.buffers) { buffer.bytes = {}; }
+		}
 	}
 };
 
@@ -643,6 +1235,27 @@ void detail::expect(bool pred, char const* expr) noexcept(false) {
 	throw Error{print_error(expr)};
 }
 
+void detail::dequantize(Accessor::Data const& data, bool normalized, std::span<float> out) {
+	auto write = [normalized, out](auto const& d) {
+		using T = std::remove_cvref_t<decltype(d[0])>;
+		auto const in = std::span<T const>{d.span()};
+		expect(in.size() == out.size(), "in.size() == out.size()");
+		if constexpr (std::is_same_v<T, float>) {
+			if (!in.empty()) { std::memcpy(out.data(), in.data(), in.size_bytes()); }
+		} else if constexpr (std::is_same_v<T, std::uint32_t>) {
+			// normalized is not valid for unsigned int components
+			convert_components(in, out);
+		} else {
+			if (normalized) {
+				normalize_components(in, out);
+			} else {
+				convert_components(in, out);
+			}
+		}
+	};
+	std::visit(write, data);
+}
+
 std::span<std::byte const> BufferView::to_span(std::span<Buffer const> buffers) const {
 	if (buffer >= buffers.size()) { throw Error{"Invalid buffer view"}; }
 	auto const& b = buffers[buffer];
@@ -663,33 +1276,115 @@ auto Accessor::to_type(std::string_view const key) -> Type {
 	throw Error{detail::print_error(err.c_str())};
 }
 
+auto Accessor::data() const -> Data const& {
+	static auto const empty_v = Data{};
+	if (!storage) { return empty_v; }
+	std::call_once(storage->once, [this] {
+		auto info = DecodeInfo{.bounds = storage->bounds, .sparse = sparse ? &*sparse : nullptr, .allocation = storage->allocation};
+		storage->data = make_accessor_data(storage->source, component_type, layout, info);
+		storage->out_of_bounds = info.out_of_bounds;
+		storage->source = {};
+		storage->decoded = true;
+	});
+	return storage->data;
+}
+
+bool Accessor::decoded() const { return !storage || storage->decoded; }
+
+bool Accessor::out_of_bounds() const {
+	data();
+	return storage && storage->out_of_bounds;
+}
+
 std::vector<std::uint32_t> Accessor::to_u32() const {
+	auto const& data = this->data();
+	if (auto const* d = std::get_if<UnsignedInt>(&data)) { return {d->span().begin(), d->span().end()}; }
 	auto ret = std::vector<std::uint32_t>{};
-	if (auto const* d = std::get_if<UnsignedInt>(&data)) {
+	if (auto const* d = std::get_if<UnsignedShort>(&data)) {
 		ret.resize(d->size());
-		std::memcpy(ret.data(), d->data(), d->span().size_bytes());
+		detail::widen(d->span(), ret);
 	} else {
-		EXPECT(std::holds_alternative<UnsignedByte>(data) || std::holds_alternative<UnsignedShort>(data));
-		auto write = [&ret](auto const& d) {
-			ret.reserve(d.size());
-			for (auto const i : d.span()) { ret.push_back(static_cast<std::uint32_t>(i)); }
-		};
-		std::visit(write, data);
+		auto const* u8 = std::get_if<UnsignedByte>(&data);
+		EXPECT(u8);
+		ret.resize(u8->size());
+		detail::widen(u8->span(), ret);
 	}
 	return ret;
 }
 
+Indices Accessor::to_indices() const {
+	auto const& data = this->data();
+	if (auto const* d = std::get_if<UnsignedInt>(&data)) { return Indices{std::vector<std::uint32_t>{d->span().begin(), d->span().end()}}; }
+	if (auto const* d = std::get_if<UnsignedShort>(&data)) { return Indices{std::vector<std::uint16_t>{d->span().begin(), d->span().end()}}; }
+	auto const* u8 = std::get_if<UnsignedByte>(&data);
+	EXPECT(u8);
+	auto ret = std::vector<std::uint16_t>(u8->size());
+	detail::widen(u8->span(), ret);
+	return Indices{std::move(ret)};
+}
+
 std::vector<Mat4x4> Accessor::to_mat4() const {
 	EXPECT(type == Type::eMat4);
-	EXPECT(std::holds_alternative<Float>(data));
+	EXPECT(std::holds_alternative<Float>(data()));
 	auto ret = std::vector<Mat4x4>{};
-	auto const& d = std::get<Float>(data);
+	auto const& d = std::get<Float>(data());
 	EXPECT(d.size() % 16 == 0);
 	ret.resize(d.size() / 16);
 	std::memcpy(ret.data(), d.data(), d.span().size_bytes());
 	return ret;
 }
 
+MemoryUsage Root::memory_usage() const {
+	auto ret = MemoryUsage{};
+	auto const aliases_buffer = [this](std::byte const* data) {
+		return std::ranges::any_of(buffers, [data](Buffer const& buffer) {
+			auto const span = buffer.bytes.span();
+			return !span.empty() && !std::less<>{}(data, span.data()) && std::less<>{}(data, span.data() + span.size());
+		});
+	};
+	auto const owned = [&](std::span<std::byte const> bytes) -> std::size_t { return bytes.empty() || aliases_buffer(bytes.data()) ? 0u : bytes.size(); };
+	auto const owned_data = [&](Accessor::Data const& data) { return std::visit([&](auto const& d) { return owned(std::as_bytes(d.span())); }, data); };
+
+	for (auto const& buffer : buffers) { ret.buffers += buffer.bytes.size(); }
+	for (auto const& accessor : accessors) {
+		if (auto const* storage = accessor.storage.get()) {
+			// source is released once decoded
+			ret.accessors += storage->decoded ? owned_data(storage->data) : owned(storage->source.span());
+		}
+		if (accessor.sparse) { ret.accessors += vector_bytes(accessor.sparse->indices) + owned_data(accessor.sparse->values); }
+	}
+	for (auto const& mesh : meshes) {
+		for (auto const& primitive : mesh.primitives) {
+			ret.geometry += geometry_bytes(primitive.geometry);
+			for (auto const& target : primitive.targets) { ret.geometry += geometry_bytes(target); }
+		}
+	}
+	for (auto const& image : images) { ret.images += owned(image.bytes.span()); }
+	return ret;
+}
+
+bool Glb::is_glb(std::span<std::byte const> bytes) { return bytes.size() >= glb::header_size_v && glb::read_u32(bytes, 0) == glb::magic_v; }
+
+Glb Glb::from(ByteArray const& bytes) {
+	auto const span = std::span<std::byte const>{bytes.span()};
+	if (!is_glb(span) || glb::read_u32(span, 4) != glb::version_v) { return {}; }
+	auto const length = std::min(std::size_t{glb::read_u32(span, 8)}, span.size());
+	auto ret = Glb{};
+	for (auto offset = glb::header_size_v; offset + glb::chunk_header_size_v <= length;) {
+		auto const chunk_length = std::size_t{glb::read_u32(span, offset)};
+		auto const chunk_type = glb::read_u32(span, offset + 4);
+		offset += glb::chunk_header_size_v;
+		if (offset + chunk_length > length) { return {}; }
+		if (chunk_type == glb::chunk_json_v) {
+			ret.json = dj::Json::parse(std::string_view{reinterpret_cast<char const*>(span.data() + offset), chunk_length});
+		} else if (chunk_type == glb::chunk_bin_v && !ret.bin) {
+			ret.bin = bytes.share(offset, chunk_length);
+		}
+		offset += chunk_length;
+	}
+	return ret;
+}
+
 Metadata Parser::metadata() const {
 	auto ret = Metadata{};
 	ret.images = json["images"].array_view().size();
@@ -701,9 +1396,19 @@ Metadata Parser::metadata() const {
 	return ret;
 }
 
-Root Parser::parse(GetBytes const& get_bytes) const {
+Root Parser::parse(GetBytes const& get_bytes, ParseOptions const& options) const {
+	if (!get_bytes) { return parse_owning({}, options); }
+	auto const load_bytes = [&get_bytes, &options](std::string_view uri) {
+		auto const bytes = get_bytes(uri);
+		if (bytes.empty()) { return ByteArray{}; }
+		return ByteArray{bytes, Allocation{.resource = options.resource, .alignment = options.alignment}};
+	};
+	return parse_owning(load_bytes, options);
+}
+
+Root Parser::parse_owning(LoadBytes const& load_bytes, ParseOptions const& options) const {
 	auto ret = Root{};
-	GltfParser{get_bytes, ret}.parse(json);
+	GltfParser{load_bytes, bin, options, ret}.parse(json);
 
 	auto const& nodes = json["nodes"].array_view();
 	ret.nodes.reserve(nodes.size());
@@ -722,7 +1427,8 @@ Root Parser::parse(GetBytes const& get_bytes) const {
 			if (node.weights.empty()) {
 				auto const& m = ret.meshes[*node.mesh];
 				if (m.weights.empty()) {
-					node.weights.resize(m.primitives[0].targets.size());
+					// unselected meshes have no primitives
+					if (!m.primitives.empty()) { node.weights.resize(m.primitives[0].targets.size()); }
 				} else {
 					node.weights = m.weights;
 				}
@@ -758,12 +1464,18 @@ Root Parser::parse(GetBytes const& get_bytes) const {
 	return ret;
 }
 
-Root parse(char const* json_path) {
-	if (!fs::is_regular_file(json_path)) { return {}; }
-	auto json = dj::Json::from_file(json_path);
+Root parse(char const* path, ParseOptions const& options) {
+	if (!fs::is_regular_file(path)) { return {}; }
+	auto bytes = map_file(path);
+	auto reader = Reader{fs::path{path}.parent_path()};
+	auto load_bytes = [&reader](std::string_view uri) { return reader(std::string{uri}); };
+	if (Glb::is_glb(bytes.span())) {
+		auto glb = Glb::from(bytes);
+		if (!glb.json) { return {}; }
+		return Parser{glb.json, std::move(glb.bin)}.parse_owning(load_bytes, options);
+	}
+	auto json = dj::Json::parse(std::string_view{reinterpret_cast<char const*>(bytes.data()), bytes.size()});
 	if (!json) { return {}; }
-	auto reader = Reader{fs::path{json_path}.parent_path()};
-	auto get_bytes = [&reader](std::string_view uri) { return reader(std::string{uri}); };
-	return Parser{json}.parse(get_bytes);
+	return Parser{json}.parse_owning(load_bytes, options);
 }
 } // namespace gltf2cpp
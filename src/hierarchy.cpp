@@ -0,0 +1,229 @@
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/hierarchy.hpp>
+#include <algorithm>
+#include <type_traits>
+
+// SSE2 is part of the x86-64 baseline; four lanes match the four components of a matrix column.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLTF2CPP_HIERARCHY_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define GLTF2CPP_HIERARCHY_NEON
+#include <arm_neon.h>
+#endif
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+constexpr std::size_t lanes_v{4};
+
+// Four floats: either one component of four entries (Trs -> matrix), or one column of a matrix (parent * local).
+#if defined(GLTF2CPP_HIERARCHY_SSE2)
+using Lanes = __m128;
+Lanes load(float const* in) { return _mm_loadu_ps(in); }
+void store(float* out, Lanes const v) { _mm_storeu_ps(out, v); }
+Lanes splat(float const f) { return _mm_set1_ps(f); }
+Lanes add(Lanes const a, Lanes const b) { return _mm_add_ps(a, b); }
+Lanes sub(Lanes const a, Lanes const b) { return _mm_sub_ps(a, b); }
+Lanes mul(Lanes const a, Lanes const b) { return _mm_mul_ps(a, b); }
+#elif defined(GLTF2CPP_HIERARCHY_NEON)
+using Lanes = float32x4_t;
+Lanes load(float const* in) { return vld1q_f32(in); }
+void store(float* out, Lanes const v) { vst1q_f32(out, v); }
+Lanes splat(float const f) { return vdupq_n_f32(f); }
+Lanes add(Lanes const a, Lanes const b) { return vaddq_f32(a, b); }
+Lanes sub(Lanes const a, Lanes const b) { return vsubq_f32(a, b); }
+Lanes mul(Lanes const a, Lanes const b) { return vmulq_f32(a, b); }
+#else
+struct Lanes {
+	float v[lanes_v];
+};
+
+Lanes load(float const* in) { return {in[0], in[1], in[2], in[3]}; }
+void store(float* out, Lanes const& v) { std::copy_n(v.v, lanes_v, out); }
+Lanes splat(float const f) { return {f, f, f, f}; }
+
+template <typename F>
+Lanes apply(Lanes const& a, Lanes const& b, F f) {
+	return {f(a.v[0], b.v[0]), f(a.v[1], b.v[1]), f(a.v[2], b.v[2]), f(a.v[3], b.v[3])};
+}
+
+Lanes add(Lanes const& a, Lanes const& b) { return apply(a, b, [](float x, float y) { return x + y; }); }
+Lanes sub(Lanes const& a, Lanes const& b) { return apply(a, b, [](float x, float y) { return x - y; }); }
+Lanes mul(Lanes const& a, Lanes const& b) { return apply(a, b, [](float x, float y) { return x * y; }); }
+#endif
+
+// Column major upper 3x4 of the matrices of four entries: out[c * 3 + r][lane].
+using Composed = float[12][lanes_v];
+
+// Translation * Rotation * Scale, with the same operations (and order) as to_matrix().
+void compose(std::array<float const*, 3> const& t, std::array<float const*, 4> const& q, std::array<float const*, 3> const& s, Composed& out) {
+	auto const x = load(q[0]);
+	auto const y = load(q[1]);
+	auto const z = load(q[2]);
+	auto const w = load(q[3]);
+	auto const one = splat(1.0f);
+	auto const two = splat(2.0f);
+	auto const xx = mul(x, x);
+	auto const yy = mul(y, y);
+	auto const zz = mul(z, z);
+	auto const xy = mul(x, y);
+	auto const xz = mul(x, z);
+	auto const yz = mul(y, z);
+	auto const wx = mul(w, x);
+	auto const wy = mul(w, y);
+	auto const wz = mul(w, z);
+	auto const sx = load(s[0]);
+	auto const sy = load(s[1]);
+	auto const sz = load(s[2]);
+	store(out[0], mul(sub(one, mul(two, add(yy, zz))), sx));
+	store(out[1], mul(mul(two, add(xy, wz)), sx));
+	store(out[2], mul(mul(two, sub(xz, wy)), sx));
+	store(out[3], mul(mul(two, sub(xy, wz)), sy));
+	store(out[4], mul(sub(one, mul(two, add(xx, zz))), sy));
+	store(out[5], mul(mul(two, add(yz, wx)), sy));
+	store(out[6], mul(mul(two, add(xz, wy)), sz));
+	store(out[7], mul(mul(two, sub(yz, wx)), sz));
+	store(out[8], mul(sub(one, mul(two, add(xx, yy))), sz));
+	for (std::size_t r = 0; r < 3; ++r) { store(out[9 + r], load(t[r])); }
+}
+
+void multiply(Mat4x4 const& a, Mat4x4 const& b, Mat4x4& out) {
+	Lanes const columns[4]{load(a[0].data()), load(a[1].data()), load(a[2].data()), load(a[3].data())};
+	for (std::size_t c = 0; c < 4; ++c) {
+		auto column = mul(columns[0], splat(b[c][0]));
+		for (std::size_t k = 1; k < 4; ++k) { column = add(column, mul(columns[k], splat(b[c][k]))); }
+		store(out[c].data(), column);
+	}
+}
+
+constexpr std::size_t padded(std::size_t const count) { return (count + lanes_v - 1) / lanes_v * lanes_v; }
+} // namespace
+
+Mat4x4 to_matrix(Transform const& transform) {
+	if (auto const* matrix = std::get_if<Mat4x4>(&transform)) { return *matrix; }
+	auto const& trs = std::get<Trs>(transform);
+	auto const [x, y, z, w] = trs.rotation;
+	auto const& s = trs.scale;
+	auto const& t = trs.translation;
+	return Mat4x4{{
+		Vec<4>{(1.0f - 2.0f * (y * y + z * z)) * s[0], 2.0f * (x * y + w * z) * s[0], 2.0f * (x * z - w * y) * s[0], 0.0f},
+		Vec<4>{2.0f * (x * y - w * z) * s[1], (1.0f - 2.0f * (x * x + z * z)) * s[1], 2.0f * (y * z + w * x) * s[1], 0.0f},
+		Vec<4>{2.0f * (x * z + w * y) * s[2], 2.0f * (y * z - w * x) * s[2], (1.0f - 2.0f * (x * x + y * y)) * s[2], 0.0f},
+		Vec<4>{t[0], t[1], t[2], 1.0f},
+	}};
+}
+
+TransformHierarchy::TransformHierarchy(Root const& root) : m_entries(root.nodes.size(), npos_v) {
+	// depth first, children in order: parents precede their children and subtrees are contiguous
+	struct Visit {
+		Index<Node> node{};
+		std::size_t parent{};
+	};
+	auto stack = std::vector<Visit>{};
+	auto const visit = [&](Index<Node> const root_node) {
+		EXPECT(root_node < root.nodes.size());
+		if (m_entries[root_node] != npos_v) { return; }
+		stack.push_back({root_node, npos_v});
+		while (!stack.empty()) {
+			auto const [node, parent] = stack.back();
+			stack.pop_back();
+			// a Node reachable more than once (malformed hierarchy) is only added once
+			if (m_entries[node] != npos_v) { continue; }
+			auto const entry = m_nodes.size();
+			m_entries[node] = entry;
+			m_nodes.push_back(node);
+			m_parents.push_back(parent);
+			auto const& children = root.nodes[node].children;
+			for (auto it = children.rbegin(); it != children.rend(); ++it) {
+				EXPECT(*it < root.nodes.size());
+				stack.push_back({*it, entry});
+			}
+		}
+	};
+	for (auto const& scene : root.scenes) {
+		for (auto const node : scene.root_nodes) { visit(node); }
+	}
+	for (std::size_t node = 0; node < root.nodes.size(); ++node) {
+		if (!root.nodes[node].parent) { visit(node); }
+	}
+
+	auto const identity = Trs{};
+	for (std::size_t c = 0; c < 3; ++c) { m_translation[c].resize(padded(size()), identity.translation[c]); }
+	for (std::size_t c = 0; c < 4; ++c) { m_rotation[c].resize(padded(size()), identity.rotation[c]); }
+	for (std::size_t c = 0; c < 3; ++c) { m_scale[c].resize(padded(size()), identity.scale[c]); }
+	m_is_matrix.resize(size());
+	m_dirty.resize(size());
+	m_local.resize(size());
+	m_world.resize(size());
+	for (std::size_t i = 0; i < size(); ++i) { set_local(m_nodes[i], root.nodes[m_nodes[i]].transform); }
+	update();
+}
+
+void TransformHierarchy::set_local(Index<Node> const node, Transform const& transform) {
+	auto const entry = checked_entry(node);
+	m_dirty[entry] = 1;
+	if (auto const* matrix = std::get_if<Mat4x4>(&transform)) {
+		m_local[entry] = *matrix;
+		m_is_matrix[entry] = 1;
+		return;
+	}
+	auto const& trs = std::get<Trs>(transform);
+	for (std::size_t c = 0; c < 3; ++c) { m_translation[c][entry] = trs.translation[c]; }
+	for (std::size_t c = 0; c < 4; ++c) { m_rotation[c][entry] = trs.rotation[c]; }
+	for (std::size_t c = 0; c < 3; ++c) { m_scale[c][entry] = trs.scale[c]; }
+	m_is_matrix[entry] = 0;
+}
+
+Mat4x4 const& TransformHierarchy::local(Index<Node> const node) const { return m_local[checked_entry(node)]; }
+
+Mat4x4 const& TransformHierarchy::world(Index<Node> const node) const { return m_world[checked_entry(node)]; }
+
+std::size_t TransformHierarchy::update() {
+	// local matrices: whole groups of four entries are composed if any of them is dirty
+	Composed composed{};
+	for (std::size_t first = 0; first < size(); first += lanes_v) {
+		auto const count = std::min(lanes_v, size() - first);
+		auto const dirty = m_dirty.begin() + static_cast<std::ptrdiff_t>(first);
+		if (std::none_of(dirty, dirty + static_cast<std::ptrdiff_t>(count), [](std::uint8_t d) { return d != 0; })) { continue; }
+		auto const at = [first](auto const& arrays) {
+			auto ret = std::array<float const*, std::tuple_size_v<std::remove_cvref_t<decltype(arrays)>>>{};
+			for (std::size_t c = 0; c < ret.size(); ++c) { ret[c] = arrays[c].data() + first; }
+			return ret;
+		};
+		compose(at(m_translation), at(m_rotation), at(m_scale), composed);
+		for (std::size_t lane = 0; lane < count; ++lane) {
+			auto const entry = first + lane;
+			if (!m_dirty[entry] || m_is_matrix[entry]) { continue; }
+			auto& out = m_local[entry];
+			for (std::size_t c = 0; c < 4; ++c) {
+				for (std::size_t r = 0; r < 3; ++r) { out[c][r] = composed[c * 3 + r][lane]; }
+				out[c][3] = c == 3 ? 1.0f : 0.0f;
+			}
+		}
+	}
+
+	// world matrices: parents precede their children, so dirtiness propagates down in the same pass
+	auto ret = std::size_t{};
+	for (std::size_t entry = 0; entry < size(); ++entry) {
+		auto const parent = m_parents[entry];
+		if (parent != npos_v && m_dirty[parent]) { m_dirty[entry] = 1; }
+		if (!m_dirty[entry]) { continue; }
+		if (parent == npos_v) {
+			m_world[entry] = m_local[entry];
+		} else {
+			multiply(m_world[parent], m_local[entry], m_world[entry]);
+		}
+		++ret;
+	}
+	std::fill(m_dirty.begin(), m_dirty.end(), std::uint8_t{});
+	return ret;
+}
+
+std::size_t TransformHierarchy::checked_entry(Index<Node> const node) const {
+	auto const ret = entry(node);
+	EXPECT(ret != npos_v);
+	return ret;
+}
+} // namespace gltf2cpp
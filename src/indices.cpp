@@ -0,0 +1,121 @@
+#include <detail/widen.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <cassert>
+
+// SSE2 is part of the x86-64 baseline; wider (AVX2) kernels are not worth a runtime dispatch, widening is bound by memory bandwidth.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLTF2CPP_WIDEN_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define GLTF2CPP_WIDEN_NEON
+#include <arm_neon.h>
+#endif
+
+namespace gltf2cpp {
+namespace {
+// Each kernel widens whole blocks and returns the number of elements written; the scalar loop takes over from there.
+#if defined(GLTF2CPP_WIDEN_SSE2)
+std::size_t widen_simd(std::uint16_t const* in, std::size_t const count, std::uint32_t* out) {
+	auto const zero = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(v, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(v, zero));
+	}
+	return i;
+}
+
+std::size_t widen_simd(std::uint8_t const* in, std::size_t const count, std::uint32_t* out) {
+	auto const zero = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+		auto const lo = _mm_unpacklo_epi8(v, zero);
+		auto const hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+	return i;
+}
+
+std::size_t widen_simd(std::uint8_t const* in, std::size_t const count, std::uint16_t* out) {
+	auto const zero = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(v, zero));
+	}
+	return i;
+}
+#elif defined(GLTF2CPP_WIDEN_NEON)
+std::size_t widen_simd(std::uint16_t const* in, std::size_t const count, std::uint32_t* out) {
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto const v = vld1q_u16(in + i);
+		vst1q_u32(out + i, vmovl_u16(vget_low_u16(v)));
+		vst1q_u32(out + i + 4, vmovl_u16(vget_high_u16(v)));
+	}
+	return i;
+}
+
+std::size_t widen_simd(std::uint8_t const* in, std::size_t const count, std::uint32_t* out) {
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto const v = vmovl_u8(vld1_u8(in + i));
+		vst1q_u32(out + i, vmovl_u16(vget_low_u16(v)));
+		vst1q_u32(out + i + 4, vmovl_u16(vget_high_u16(v)));
+	}
+	return i;
+}
+
+std::size_t widen_simd(std::uint8_t const* in, std::size_t const count, std::uint16_t* out) {
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8) { vst1q_u16(out + i, vmovl_u8(vld1_u8(in + i))); }
+	return i;
+}
+#else
+template <typename S, typename D>
+std::size_t widen_simd(S const*, std::size_t, D*) {
+	return 0;
+}
+#endif
+
+template <typename S, typename D>
+void widen_impl(std::span<S const> in, std::span<D> out) {
+	assert(out.size() >= in.size());
+	auto i = widen_simd(in.data(), in.size(), out.data());
+	for (; i < in.size(); ++i) { out[i] = static_cast<D>(in[i]); }
+}
+} // namespace
+
+void detail::widen(std::span<std::uint16_t const> in, std::span<std::uint32_t> out) { widen_impl(in, out); }
+void detail::widen(std::span<std::uint8_t const> in, std::span<std::uint32_t> out) { widen_impl(in, out); }
+void detail::widen(std::span<std::uint8_t const> in, std::span<std::uint16_t> out) { widen_impl(in, out); }
+
+std::span<std::uint16_t const> Indices::u16() const {
+	if (auto const* ret = std::get_if<std::vector<std::uint16_t>>(&m_storage)) { return *ret; }
+	return {};
+}
+
+std::span<std::uint32_t const> Indices::u32() const {
+	if (auto const* ret = std::get_if<std::vector<std::uint32_t>>(&m_storage)) { return *ret; }
+	return {};
+}
+
+std::span<std::byte const> Indices::bytes() const {
+	return std::visit([](auto const& v) { return std::as_bytes(std::span{v}); }, m_storage);
+}
+
+std::vector<std::uint32_t> Indices::to_u32() const {
+	if (auto const* ret = std::get_if<std::vector<std::uint32_t>>(&m_storage)) { return *ret; }
+	auto const in = u16();
+	auto ret = std::vector<std::uint32_t>(in.size());
+	detail::widen(in, ret);
+	return ret;
+}
+} // namespace gltf2cpp
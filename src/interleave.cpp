@@ -0,0 +1,157 @@
+#include <detail/component.hpp>
+#include <gltf2cpp/interleave.hpp>
+#include <gltf2cpp/vertex.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+// vertices are written in blocks, each attribute in turn, so that a block of output stays in cache
+constexpr std::size_t block_size_v{256};
+
+template <typename T>
+constexpr float to_float(T const value, bool const normalized) {
+	if constexpr (std::is_floating_point_v<T> || std::is_same_v<T, std::uint32_t>) {
+		return static_cast<float>(value);
+	} else {
+		if (!normalized) { return static_cast<float>(value); }
+		auto const ret = static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+		if constexpr (std::is_signed_v<T>) { return std::max(ret, -1.0f); }
+		return ret;
+	}
+}
+
+template <typename T>
+T saturate(double const value) {
+	using Limits = std::numeric_limits<T>;
+	return static_cast<T>(std::clamp(value, static_cast<double>(Limits::lowest()), static_cast<double>(Limits::max())));
+}
+
+template <typename T>
+T from_float(float const value, bool const normalized) {
+	if constexpr (std::is_floating_point_v<T>) {
+		return value;
+	} else {
+		if (!normalized) { return saturate<T>(std::round(static_cast<double>(value))); }
+		static constexpr auto min_v = std::is_signed_v<T> ? -1.0f : 0.0f;
+		return static_cast<T>(std::round(std::clamp(value, min_v, 1.0f) * static_cast<float>(std::numeric_limits<T>::max())));
+	}
+}
+
+template <typename S, typename D>
+D convert(S const value, bool const src_normalized, bool const dst_normalized) {
+	if constexpr (std::is_integral_v<S> && std::is_integral_v<D>) {
+		if (!src_normalized && !dst_normalized) { return saturate<D>(static_cast<double>(value)); }
+	}
+	return from_float<D>(to_float(value, src_normalized), dst_normalized);
+}
+
+struct Writer {
+	using Func = void (*)(Writer const&, std::size_t, std::size_t, std::byte*);
+
+	Func func{};
+	void const* source{};
+	std::size_t source_components{};
+	bool source_normalized{};
+	std::size_t components{};
+	bool normalized{};
+	std::size_t offset{};
+	std::size_t stride{};
+};
+
+// Direct: source and destination formats are identical, components are copied as-is.
+template <typename S, typename D, bool Direct>
+void write_block(Writer const& w, std::size_t const first, std::size_t const count, std::byte* out) {
+	auto const* src = static_cast<S const*>(w.source) + first * w.source_components;
+	auto* dst = out + first * w.stride + w.offset;
+	auto const present = std::min(w.components, w.source_components);
+	D element[4]{};
+	if (w.components == 4 && present < 4) { element[3] = detail::one<D>(w.normalized); }
+	for (std::size_t i = 0; i < count; ++i, src += w.source_components, dst += w.stride) {
+		if constexpr (Direct) {
+			std::memcpy(element, src, present * sizeof(D));
+		} else {
+			for (std::size_t c = 0; c < present; ++c) { element[c] = convert<S, D>(src[c], w.source_normalized, w.normalized); }
+		}
+		std::memcpy(dst, element, w.components * sizeof(D));
+	}
+}
+
+template <typename S, typename D>
+Writer::Func select_writer(bool const source_normalized, bool const normalized) {
+	if constexpr (std::is_same_v<S, D>) {
+		if (source_normalized == normalized) { return &write_block<S, D, true>; }
+	}
+	return &write_block<S, D, false>;
+}
+
+template <typename S>
+Writer::Func select_writer(ComponentType const type, bool const source_normalized, bool const normalized) {
+	switch (type) {
+	case ComponentType::eByte: return select_writer<S, std::int8_t>(source_normalized, normalized);
+	case ComponentType::eUnsignedByte: return select_writer<S, std::uint8_t>(source_normalized, normalized);
+	case ComponentType::eShort: return select_writer<S, std::int16_t>(source_normalized, normalized);
+	case ComponentType::eUnsignedShort: return select_writer<S, std::uint16_t>(source_normalized, normalized);
+	case ComponentType::eUnsignedInt: return select_writer<S, std::uint32_t>(source_normalized, normalized);
+	case ComponentType::eFloat: return select_writer<S, float>(source_normalized, normalized);
+	}
+	return {};
+}
+
+} // namespace
+
+InterleavedVertices interleave(Mesh::Primitive const& primitive, std::span<Accessor const> accessors, VertexLayout const& layout) {
+	EXPECT(layout.stride > 0);
+	auto ret = InterleavedVertices{.stride = layout.stride};
+	auto writers = std::vector<Writer>{};
+	writers.reserve(layout.attributes.size());
+	auto count = std::optional<std::size_t>{};
+	// bytes of a vertex that are written by some Writer: padding and absent Attributes are zero-filled
+	auto covered = std::vector<bool>(layout.stride);
+	for (auto const& attribute : layout.attributes) {
+		EXPECT(attribute.components > 0 && attribute.components <= 4);
+		EXPECT(attribute.offset + attribute.components * detail::component_size(attribute.component_type) <= layout.stride);
+		EXPECT(!attribute.normalized || attribute.component_type != ComponentType::eUnsignedInt);
+		auto const it = primitive.geometry.attributes.find(attribute.semantic);
+		if (it == primitive.geometry.attributes.end()) { continue; }
+		EXPECT(it->second < accessors.size());
+		auto const& accessor = accessors[it->second];
+		if (!count) { count = accessor.count; }
+		EXPECT(accessor.count == *count);
+		auto writer = Writer{
+			.source_components = Accessor::type_coeff(accessor.type),
+			.source_normalized = accessor.normalized,
+			.components = attribute.components,
+			.normalized = attribute.normalized,
+			.offset = attribute.offset,
+			.stride = layout.stride,
+		};
+		auto const select = [&](auto const& data) {
+			using S = std::remove_cvref_t<decltype(data[0])>;
+			EXPECT(data.size() == accessor.count * writer.source_components);
+			writer.source = data.data();
+			writer.func = select_writer<S>(attribute.component_type, writer.source_normalized, writer.normalized);
+		};
+		std::visit(select, accessor.data());
+		// null for an invalid ComponentType
+		EXPECT(writer.func);
+		writers.push_back(writer);
+		auto const first = covered.begin() + static_cast<std::ptrdiff_t>(attribute.offset);
+		std::fill_n(first, attribute.components * detail::component_size(attribute.component_type), true);
+	}
+	if (!count) { return ret; }
+	ret.count = *count;
+	auto const gaps = std::ranges::find(covered, false) != covered.end();
+	ret.bytes = ByteArray{ret.count * layout.stride, Allocation{.initialize = gaps}};
+	for (std::size_t first = 0; first < ret.count; first += block_size_v) {
+		auto const block = std::min(block_size_v, ret.count - first);
+		for (auto const& writer : writers) { writer.func(writer, first, block, ret.bytes.data()); }
+	}
+	return ret;
+}
+} // namespace gltf2cpp
@@ -0,0 +1,56 @@
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <filesystem>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gltf2cpp {
+namespace fs = std::filesystem;
+
+#if defined(_WIN32)
+ByteArray map_file(char const* path) {
+	auto const wpath = fs::path{path}.wstring();
+	auto file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { return {}; }
+	auto size = LARGE_INTEGER{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+		CloseHandle(file);
+		return {};
+	}
+	auto mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) { return {}; }
+	// the view keeps the mapping object alive
+	auto* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view) { return {}; }
+	auto data = std::shared_ptr<std::byte[]>{static_cast<std::byte*>(view), [](std::byte* mapped) { UnmapViewOfFile(mapped); }};
+	return ByteArray{std::move(data), static_cast<std::size_t>(size.QuadPart)};
+}
+#else
+ByteArray map_file(char const* path) {
+	auto const fd = open(path, O_RDONLY);
+	if (fd < 0) { return {}; }
+	struct stat st {};
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		close(fd);
+		return {};
+	}
+	auto const size = static_cast<std::size_t>(st.st_size);
+	// the mapping remains valid after the descriptor is closed
+	auto* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (ptr == MAP_FAILED) { return {}; }
+	auto data = std::shared_ptr<std::byte[]>{static_cast<std::byte*>(ptr), [size](std::byte* mapped) { munmap(mapped, size); }};
+	return ByteArray{std::move(data), size};
+}
+#endif
+} // namespace gltf2cpp
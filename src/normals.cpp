@@ -0,0 +1,154 @@
+#include <detail/geometry.hpp>
+#include <detail/parallel.hpp>
+#include <detail/vec_math.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/process.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+// triangles / vertices are processed in parallel chunks of this size
+constexpr std::size_t chunk_size_v{16 * 1024};
+constexpr Vec<3> fallback_v{0.0f, 0.0f, 1.0f};
+
+// Triangle list topology: corner c is vertex indices[c] of triangle c / 3.
+// Corners of each vertex are listed in corner order, so that per vertex sums are deterministic.
+struct Topology {
+	std::vector<std::uint32_t> indices{};
+	std::vector<std::uint32_t> offsets{};
+	std::vector<std::uint32_t> corners{};
+
+	std::size_t triangle_count() const { return indices.size() / 3; }
+	std::span<std::uint32_t const> vertex_corners(std::size_t const v) const { return std::span{corners}.subspan(offsets[v], offsets[v + 1] - offsets[v]); }
+};
+
+Topology make_topology(Indices const& indices, std::size_t const vertex_count) {
+	auto ret = Topology{.indices = indices.to_u32()};
+	if (ret.indices.empty()) {
+		ret.indices.resize(vertex_count);
+		for (std::size_t i = 0; i < vertex_count; ++i) { ret.indices[i] = static_cast<std::uint32_t>(i); }
+	}
+	ret.indices.resize(ret.triangle_count() * 3);
+	EXPECT(std::ranges::all_of(ret.indices, [vertex_count](std::uint32_t i) { return i < vertex_count; }));
+	ret.offsets.resize(vertex_count + 1);
+	for (auto const index : ret.indices) { ++ret.offsets[index + 1]; }
+	for (std::size_t v = 0; v < vertex_count; ++v) { ret.offsets[v + 1] += ret.offsets[v]; }
+	ret.corners.resize(ret.indices.size());
+	auto cursors = std::vector<std::uint32_t>(ret.offsets.begin(), ret.offsets.end() - 1);
+	for (std::size_t c = 0; c < ret.indices.size(); ++c) { ret.corners[cursors[ret.indices[c]]++] = static_cast<std::uint32_t>(c); }
+	return ret;
+}
+
+// unit face normal of each triangle (zero if degenerate), and angle of each corner
+struct Faces {
+	std::vector<Vec<3>> normals{};
+	std::vector<float> angles{};
+};
+
+template <typename Position>
+Faces make_faces(Topology const& topology, Position position, std::size_t const threads) {
+	auto ret = Faces{.normals = std::vector<Vec<3>>(topology.triangle_count()), .angles = std::vector<float>(topology.indices.size())};
+	detail::parallel_chunks(topology.triangle_count(), threads, chunk_size_v, [&](std::size_t const t) {
+		auto const* triangle = topology.indices.data() + t * 3;
+		auto const p = std::array{position(triangle[0]), position(triangle[1]), position(triangle[2])};
+		ret.normals[t] = detail::normalize(detail::cross(detail::sub(p[1], p[0]), detail::sub(p[2], p[0])));
+		for (std::size_t c = 0; c < 3; ++c) { ret.angles[t * 3 + c] = detail::angle(detail::sub(p[(c + 1) % 3], p[c]), detail::sub(p[(c + 2) % 3], p[c])); }
+	});
+	return ret;
+}
+
+// Normal of corner c: the angle weighted sum of the faces around its vertex that are smooth with c's face.
+// smooth is decided on the base (undisplaced) faces, so that morph targets share the base's creases.
+Vec<3> corner_normal(Topology const& topology, Faces const& faces, Faces const& base, std::uint32_t const c, float const cos_crease, bool const flat) {
+	auto const face = c / 3;
+	if (flat) { return faces.normals[face]; }
+	auto ret = Vec<3>{};
+	for (auto const d : topology.vertex_corners(topology.indices[c])) {
+		auto const other = d / 3;
+		if (other != face && detail::dot(base.normals[face], base.normals[other]) < cos_crease) { continue; }
+		ret = detail::add(ret, detail::scale(faces.normals[other], faces.angles[d]));
+	}
+	return detail::normalize(ret);
+}
+
+Vec<3> or_fallback(Vec<3> const& normal) { return detail::dot(normal, normal) > 0.0f ? normal : fallback_v; }
+} // namespace
+
+bool generate_normals(Mesh::Primitive& primitive, Normals const& normals) {
+	if (primitive.mode != PrimitiveMode::eTriangles) { return false; }
+	auto const vertex_count = detail::vertex_count(primitive);
+	if (vertex_count == 0) { return false; }
+	auto& geometry = primitive.geometry;
+	auto const topology = make_topology(geometry.indices, vertex_count);
+	auto const flat = normals.mode == Normals::Mode::eFlat;
+	auto const cos_crease = std::cos(std::clamp(normals.crease_angle, 0.0f, 3.14159265f));
+	auto const base = make_faces(topology, [&geometry](std::uint32_t v) { return geometry.positions[v]; }, normals.threads);
+
+	// corner normals, and (per vertex) corners grouped by identical normals: each group becomes one output vertex
+	auto corner_normals = std::vector<Vec<3>>(topology.indices.size());
+	auto groups = std::vector<std::uint32_t>(topology.indices.size());
+	auto group_counts = std::vector<std::uint32_t>(vertex_count);
+	detail::parallel_chunks(vertex_count, normals.threads, chunk_size_v, [&](std::size_t const v) {
+		auto const corners = topology.vertex_corners(v);
+		for (std::size_t i = 0; i < corners.size(); ++i) {
+			auto const c = corners[i];
+			corner_normals[c] = corner_normal(topology, base, base, c, cos_crease, flat);
+			auto const it = std::find_if(corners.begin(), corners.begin() + i, [&](std::uint32_t d) { return corner_normals[d] == corner_normals[c]; });
+			groups[c] = it == corners.begin() + i ? group_counts[v]++ : groups[*it];
+		}
+	});
+
+	// first output vertex of each source vertex (unreferenced vertices are kept as-is)
+	auto firsts = std::vector<std::uint32_t>(vertex_count + 1);
+	for (std::size_t v = 0; v < vertex_count; ++v) { firsts[v + 1] = firsts[v] + std::max(group_counts[v], std::uint32_t{1}); }
+	auto const count = static_cast<std::size_t>(firsts.back());
+	// source vertex and representative corner of each output vertex
+	auto sources = std::vector<std::uint32_t>(count);
+	auto representatives = std::vector<std::uint32_t>(count, std::numeric_limits<std::uint32_t>::max());
+	for (std::size_t v = 0; v < vertex_count; ++v) {
+		for (auto i = firsts[v]; i < firsts[v + 1]; ++i) { sources[i] = static_cast<std::uint32_t>(v); }
+		for (auto const c : topology.vertex_corners(v)) {
+			auto& representative = representatives[firsts[v] + groups[c]];
+			if (representative == std::numeric_limits<std::uint32_t>::max()) { representative = c; }
+		}
+	}
+
+	// morph target normal deltas: normals of the displaced positions (with the base's creases), minus base normals
+	auto target_normals = std::vector<std::vector<Vec<3>>>(primitive.targets.size());
+	for (std::size_t t = 0; t < primitive.targets.size(); ++t) {
+		auto const& target = primitive.targets[t];
+		if (target.positions.empty() || !target.normals.empty()) { continue; }
+		auto const position = [&](std::uint32_t v) { return detail::add(geometry.positions[v], target.positions[v]); };
+		auto const displaced = make_faces(topology, position, normals.threads);
+		auto& out = target_normals[t];
+		out.resize(count);
+		detail::parallel_chunks(count, normals.threads, chunk_size_v, [&](std::size_t const i) {
+			auto const c = representatives[i];
+			if (c == std::numeric_limits<std::uint32_t>::max()) { return; }
+			out[i] = detail::sub(or_fallback(corner_normal(topology, displaced, base, c, cos_crease, flat)), or_fallback(corner_normals[c]));
+		});
+	}
+
+	if (count != vertex_count) {
+		detail::expand_vertices(primitive, sources);
+		auto indices = std::vector<std::uint32_t>(topology.indices.size());
+		for (std::size_t c = 0; c < indices.size(); ++c) { indices[c] = firsts[topology.indices[c]] + groups[c]; }
+		auto const type = count <= 0x10000 && (geometry.indices.empty() || geometry.indices.is_u16()) ? ComponentType::eUnsignedShort : ComponentType::eUnsignedInt;
+		geometry.indices = detail::make_indices(std::move(indices), type);
+	}
+	geometry.normals.resize(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const c = representatives[i];
+		geometry.normals[i] = c == std::numeric_limits<std::uint32_t>::max() ? fallback_v : or_fallback(corner_normals[c]);
+	}
+	for (std::size_t t = 0; t < primitive.targets.size(); ++t) {
+		if (!target_normals[t].empty()) { primitive.targets[t].normals = std::move(target_normals[t]); }
+	}
+	return true;
+}
+} // namespace gltf2cpp
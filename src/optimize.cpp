@@ -0,0 +1,152 @@
+#include <detail/geometry.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/process.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+// Scoring as per Forsyth: vertices in the simulated LRU cache score higher the more recently they were used
+// (the last triangle's vertices get a fixed score, to avoid immediately re-using them), and vertices with
+// fewer remaining triangles are boosted, so that they are finished off instead of left stranded.
+constexpr std::size_t cache_size_v{32};
+constexpr float decay_power_v{1.5f};
+constexpr float last_triangle_score_v{0.75f};
+constexpr float valence_boost_scale_v{2.0f};
+constexpr float valence_boost_power_v{0.5f};
+constexpr std::size_t max_valence_v{64};
+
+constexpr std::uint32_t none_v{std::numeric_limits<std::uint32_t>::max()};
+
+struct ScoreTable {
+	std::array<float, cache_size_v> cache{};
+	std::array<float, max_valence_v> valence{};
+
+	ScoreTable() {
+		for (std::size_t i = 0; i < cache_size_v; ++i) {
+			if (i < 3) {
+				cache[i] = last_triangle_score_v;
+			} else {
+				auto const scale = 1.0f / static_cast<float>(cache_size_v - 3);
+				cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scale, decay_power_v);
+			}
+		}
+		for (std::size_t i = 1; i < max_valence_v; ++i) { valence[i] = valence_boost_scale_v * std::pow(static_cast<float>(i), -valence_boost_power_v); }
+	}
+
+	float operator()(std::uint32_t const cache_position, std::uint32_t const live_triangles) const {
+		if (live_triangles == 0) { return -1.0f; }
+		auto ret = valence[std::min(static_cast<std::size_t>(live_triangles), max_valence_v - 1)];
+		if (cache_position < cache_size_v) { ret += cache[cache_position]; }
+		return ret;
+	}
+};
+
+std::vector<std::uint32_t> optimize_vertex_cache(std::span<std::uint32_t const> indices, std::size_t const vertex_count) {
+	static auto const score_v = ScoreTable{};
+	auto const triangle_count = indices.size() / 3;
+
+	// vertex -> triangles adjacency: the first live[v] entries of each vertex's range are its remaining triangles
+	auto offsets = std::vector<std::uint32_t>(vertex_count + 1);
+	for (auto const index : indices) { ++offsets[index + 1]; }
+	for (std::size_t v = 0; v < vertex_count; ++v) { offsets[v + 1] += offsets[v]; }
+	auto live = std::vector<std::uint32_t>(vertex_count);
+	auto adjacency = std::vector<std::uint32_t>(indices.size());
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		auto const v = indices[i];
+		adjacency[offsets[v] + live[v]++] = static_cast<std::uint32_t>(i / 3);
+	}
+
+	auto cache_position = std::vector<std::uint32_t>(vertex_count, none_v);
+	auto vertex_score = std::vector<float>(vertex_count);
+	for (std::size_t v = 0; v < vertex_count; ++v) { vertex_score[v] = score_v(none_v, live[v]); }
+	auto triangle_score = std::vector<float>(triangle_count);
+	for (std::size_t t = 0; t < triangle_count; ++t) {
+		triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+	}
+	auto emitted = std::vector<bool>(triangle_count);
+
+	auto ret = std::vector<std::uint32_t>{};
+	ret.reserve(indices.size());
+	auto cache = std::vector<std::uint32_t>{};
+	auto next_cache = std::vector<std::uint32_t>{};
+	cache.reserve(cache_size_v + 3);
+	next_cache.reserve(cache_size_v + 3);
+	auto best = static_cast<std::uint32_t>(std::max_element(triangle_score.begin(), triangle_score.end()) - triangle_score.begin());
+	auto cursor = std::size_t{};
+
+	for (std::size_t emit = 0; emit < triangle_count; ++emit) {
+		if (best == none_v) {
+			// no cached vertex has live triangles left: resume from the first triangle not yet emitted
+			while (emitted[cursor]) { ++cursor; }
+			best = static_cast<std::uint32_t>(cursor);
+		}
+		emitted[best] = true;
+		auto const* triangle = indices.data() + best * 3;
+		next_cache.clear();
+		for (std::size_t i = 0; i < 3; ++i) {
+			auto const v = triangle[i];
+			ret.push_back(v);
+			if (std::find(next_cache.begin(), next_cache.end(), v) == next_cache.end()) { next_cache.push_back(v); }
+			auto const first = adjacency.begin() + offsets[v];
+			auto const it = std::find(first, first + live[v], best);
+			std::iter_swap(it, first + live[v] - 1);
+			--live[v];
+		}
+		for (auto const v : cache) {
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2]) { next_cache.push_back(v); }
+		}
+		std::swap(cache, next_cache);
+
+		// rescore every vertex whose cache position changed (including those that were just evicted)
+		best = none_v;
+		auto best_score = 0.0f;
+		for (std::size_t i = 0; i < cache.size(); ++i) {
+			auto const v = cache[i];
+			cache_position[v] = i < cache_size_v ? static_cast<std::uint32_t>(i) : none_v;
+			auto const score = score_v(cache_position[v], live[v]);
+			auto const delta = score - vertex_score[v];
+			vertex_score[v] = score;
+			for (auto j = offsets[v]; j < offsets[v] + live[v]; ++j) {
+				auto const t = adjacency[j];
+				triangle_score[t] += delta;
+				if (triangle_score[t] > best_score) {
+					best_score = triangle_score[t];
+					best = t;
+				}
+			}
+		}
+		if (cache.size() > cache_size_v) { cache.resize(cache_size_v); }
+	}
+	return ret;
+}
+} // namespace
+
+bool optimize(Mesh::Primitive& primitive) {
+	if (primitive.mode != PrimitiveMode::eTriangles || primitive.geometry.indices.empty()) { return false; }
+	auto const vertex_count = detail::vertex_count(primitive);
+	auto indices = primitive.geometry.indices.to_u32();
+	EXPECT(indices.size() % 3 == 0);
+	EXPECT(std::ranges::all_of(indices, [vertex_count](std::uint32_t i) { return i < vertex_count; }));
+
+	indices = optimize_vertex_cache(indices, vertex_count);
+
+	// renumber vertices in order of first use by the optimized triangles
+	auto remap = std::vector<std::uint32_t>(vertex_count, none_v);
+	auto next = std::uint32_t{};
+	for (auto& index : indices) {
+		if (remap[index] == none_v) { remap[index] = next++; }
+		index = remap[index];
+	}
+	for (auto& r : remap) {
+		if (r == none_v) { r = next++; }
+	}
+	detail::remap_vertices(primitive, remap, vertex_count);
+	primitive.geometry.indices = detail::make_indices(std::move(indices), primitive.geometry.indices.component_type());
+	return true;
+}
+} // namespace gltf2cpp
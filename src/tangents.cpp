@@ -0,0 +1,146 @@
+#include <detail/geometry.hpp>
+#include <detail/parallel.hpp>
+#include <detail/vec_math.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/process.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+// triangles / vertices are processed in parallel chunks of this size
+constexpr std::size_t chunk_size_v{16 * 1024};
+constexpr auto npos_v{std::numeric_limits<std::uint32_t>::max()};
+
+// angle weighted tangent and bitangent contributed by a triangle corner
+struct Corner {
+	Vec<3> tangent{};
+	Vec<3> bitangent{};
+};
+
+Vec<3> project(Vec<3> const& v, Vec<3> const& normal) { return detail::normalize(detail::sub(v, detail::scale(normal, detail::dot(normal, v)))); }
+
+// bitangent sign of a corner: -1 for mirrored UVs, 0 if its triangle has degenerate UVs
+float sign(Corner const& corner, Vec<3> const& normal) {
+	auto const handedness = detail::dot(detail::cross(normal, corner.tangent), corner.bitangent);
+	return handedness < 0.0f ? -1.0f : (handedness > 0.0f ? 1.0f : 0.0f);
+}
+
+// any unit vector perpendicular to normal
+Vec<3> perpendicular(Vec<3> const& normal) {
+	auto const axis = std::abs(normal[0]) < 0.9f ? Vec<3>{1.0f, 0.0f, 0.0f} : Vec<3>{0.0f, 1.0f, 0.0f};
+	return detail::normalize(detail::cross(normal, axis));
+}
+} // namespace
+
+bool generate_tangents(Mesh::Primitive& primitive, Tangents const& tangents) {
+	auto& geometry = primitive.geometry;
+	if (primitive.mode != PrimitiveMode::eTriangles || tangents.tex_coord >= geometry.tex_coords.size() || geometry.normals.empty()) { return false; }
+	auto const vertex_count = detail::vertex_count(primitive);
+	if (vertex_count == 0) { return false; }
+	auto const& positions = geometry.positions;
+	auto const& normals = geometry.normals;
+	auto const& uvs = geometry.tex_coords[tangents.tex_coord];
+	if (uvs.empty()) { return false; }
+
+	// corner c of the (implicitly indexed, if unindexed) triangle list
+	auto indices = geometry.indices.to_u32();
+	if (indices.empty()) {
+		indices.resize(vertex_count);
+		for (std::size_t i = 0; i < vertex_count; ++i) { indices[i] = static_cast<std::uint32_t>(i); }
+	}
+	auto const triangle_count = indices.size() / 3;
+	EXPECT(std::ranges::all_of(indices, [vertex_count](std::uint32_t i) { return i < vertex_count; }));
+
+	auto corners = std::vector<Corner>(triangle_count * 3);
+	detail::parallel_chunks(triangle_count, tangents.threads, chunk_size_v, [&](std::size_t const t) {
+		auto const* triangle = indices.data() + t * 3;
+		auto const e1 = detail::sub(positions[triangle[1]], positions[triangle[0]]);
+		auto const e2 = detail::sub(positions[triangle[2]], positions[triangle[0]]);
+		auto const& uv0 = uvs[triangle[0]];
+		auto const du1 = uvs[triangle[1]][0] - uv0[0], dv1 = uvs[triangle[1]][1] - uv0[1];
+		auto const du2 = uvs[triangle[2]][0] - uv0[0], dv2 = uvs[triangle[2]][1] - uv0[1];
+		auto const det = du1 * dv2 - du2 * dv1;
+		// degenerate UVs: contribute nothing, the vertex falls back to its other triangles
+		if (std::abs(det) <= 1e-20f) { return; }
+		auto const tangent = detail::scale(detail::sub(detail::scale(e1, dv2), detail::scale(e2, dv1)), 1.0f / det);
+		auto const bitangent = detail::scale(detail::sub(detail::scale(e2, du1), detail::scale(e1, du2)), 1.0f / det);
+		for (std::size_t c = 0; c < 3; ++c) {
+			auto const& p = positions[triangle[c]];
+			auto const weight = detail::angle(detail::sub(positions[triangle[(c + 1) % 3]], p), detail::sub(positions[triangle[(c + 2) % 3]], p));
+			auto const& normal = normals[triangle[c]];
+			corners[t * 3 + c] = {detail::scale(project(tangent, normal), weight), detail::scale(project(bitangent, normal), weight)};
+		}
+	});
+
+	// vertex -> corners adjacency, in corner order (so that sums are deterministic)
+	auto offsets = std::vector<std::uint32_t>(vertex_count + 1);
+	for (std::size_t c = 0; c < triangle_count * 3; ++c) { ++offsets[indices[c] + 1]; }
+	for (std::size_t v = 0; v < vertex_count; ++v) { offsets[v + 1] += offsets[v]; }
+	auto adjacency = std::vector<std::uint32_t>(offsets.back());
+	auto cursors = std::vector<std::uint32_t>(offsets.begin(), offsets.end() - 1);
+	for (std::size_t c = 0; c < triangle_count * 3; ++c) { adjacency[cursors[indices[c]]++] = static_cast<std::uint32_t>(c); }
+
+	// (per vertex) corners grouped by bitangent sign: each group becomes one output vertex
+	// corners without a tangent (degenerate UVs) join the first group
+	auto groups = std::vector<std::uint32_t>(triangle_count * 3);
+	auto group_counts = std::vector<std::uint32_t>(vertex_count);
+	detail::parallel_chunks(vertex_count, tangents.threads, chunk_size_v, [&](std::size_t const v) {
+		auto signs = std::array<std::uint32_t, 2>{npos_v, npos_v};
+		for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+			auto const c = adjacency[i];
+			auto const s = sign(corners[c], normals[v]);
+			if (s == 0.0f) { continue; }
+			auto& group = signs[s < 0.0f ? 1 : 0];
+			if (group == npos_v) { group = group_counts[v]++; }
+			groups[c] = group;
+		}
+		if (group_counts[v] == 0) { group_counts[v] = 1; }
+		for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+			auto const c = adjacency[i];
+			if (sign(corners[c], normals[v]) == 0.0f) { groups[c] = 0; }
+		}
+	});
+
+	// first output vertex of each source vertex, and source vertex of each output vertex
+	auto firsts = std::vector<std::uint32_t>(vertex_count + 1);
+	for (std::size_t v = 0; v < vertex_count; ++v) { firsts[v + 1] = firsts[v] + group_counts[v]; }
+	auto const count = static_cast<std::size_t>(firsts.back());
+	auto sources = std::vector<std::uint32_t>(count);
+	for (std::size_t v = 0; v < vertex_count; ++v) {
+		for (auto i = firsts[v]; i < firsts[v + 1]; ++i) { sources[i] = static_cast<std::uint32_t>(v); }
+	}
+
+	auto out = std::vector<Vec<4>>(count);
+	detail::parallel_chunks(vertex_count, tangents.threads, chunk_size_v, [&](std::size_t const v) {
+		auto sums = std::array<Corner, 2>{};
+		for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+			auto const c = adjacency[i];
+			auto& sum = sums[groups[c]];
+			sum.tangent = detail::add(sum.tangent, corners[c].tangent);
+			sum.bitangent = detail::add(sum.bitangent, corners[c].bitangent);
+		}
+		auto const& normal = normals[v];
+		for (std::uint32_t g = 0; g < group_counts[v]; ++g) {
+			auto tangent = project(sums[g].tangent, normal);
+			if (detail::dot(tangent, tangent) == 0.0f) { tangent = perpendicular(normal); }
+			auto const w = detail::dot(detail::cross(normal, tangent), sums[g].bitangent) < 0.0f ? -1.0f : 1.0f;
+			out[firsts[v] + g] = {tangent[0], tangent[1], tangent[2], w};
+		}
+	});
+
+	if (count != vertex_count) {
+		detail::expand_vertices(primitive, sources);
+		auto split = std::vector<std::uint32_t>(triangle_count * 3);
+		for (std::size_t c = 0; c < split.size(); ++c) { split[c] = firsts[indices[c]] + groups[c]; }
+		auto const type = count <= 0x10000 && (geometry.indices.empty() || geometry.indices.is_u16()) ? ComponentType::eUnsignedShort : ComponentType::eUnsignedInt;
+		geometry.indices = detail::make_indices(std::move(split), type);
+	}
+	geometry.tangents = std::move(out);
+	return true;
+}
+} // namespace gltf2cpp
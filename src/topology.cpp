@@ -0,0 +1,112 @@
+#include <detail/geometry.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/process.hpp>
+#include <limits>
+#include <type_traits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+// Writes list indices for count source indices of the given mode, read via in(i), in a single pass.
+// Vertex ordering follows the GLTF spec, which preserves the winding of strips and fans.
+// Degenerate triangles (used to stitch strips together) are dropped.
+template <typename Out, typename In>
+std::vector<Out> make_list(PrimitiveMode const mode, std::size_t const count, In in) {
+	auto ret = std::vector<Out>{};
+	auto const push_triangle = [&ret](std::uint32_t const a, std::uint32_t const b, std::uint32_t const c) {
+		if (a == b || b == c || c == a) { return; }
+		ret.insert(ret.end(), {static_cast<Out>(a), static_cast<Out>(b), static_cast<Out>(c)});
+	};
+	switch (mode) {
+	case PrimitiveMode::eTriangleStrip: {
+		if (count < 3) { break; }
+		ret.reserve((count - 2) * 3);
+		for (std::size_t i = 0; i + 2 < count; ++i) {
+			if (i % 2 == 0) {
+				push_triangle(in(i), in(i + 1), in(i + 2));
+			} else {
+				push_triangle(in(i), in(i + 2), in(i + 1));
+			}
+		}
+		break;
+	}
+	case PrimitiveMode::eTriangleFan: {
+		if (count < 3) { break; }
+		ret.reserve((count - 2) * 3);
+		auto const origin = in(0);
+		for (std::size_t i = 1; i + 1 < count; ++i) { push_triangle(in(i), in(i + 1), origin); }
+		break;
+	}
+	case PrimitiveMode::eLineStrip:
+	case PrimitiveMode::eLineLoop: {
+		if (count < 2) { break; }
+		ret.reserve(count * 2);
+		for (std::size_t i = 0; i + 1 < count; ++i) { ret.insert(ret.end(), {static_cast<Out>(in(i)), static_cast<Out>(in(i + 1))}); }
+		if (mode == PrimitiveMode::eLineLoop) { ret.insert(ret.end(), {static_cast<Out>(in(count - 1)), static_cast<Out>(in(0))}); }
+		break;
+	}
+	default: {
+		ret.resize(count);
+		for (std::size_t i = 0; i < count; ++i) { ret[i] = static_cast<Out>(in(i)); }
+		break;
+	}
+	}
+	return ret;
+}
+
+template <typename T>
+Indices list_indices(std::span<T const> indices, PrimitiveMode const mode) {
+	auto const in = [indices](std::size_t const i) { return static_cast<std::uint32_t>(indices[i]); };
+	if constexpr (std::is_same_v<T, std::uint32_t>) {
+		return Indices{make_list<std::uint32_t>(mode, indices.size(), in)};
+	} else {
+		return Indices{make_list<std::uint16_t>(mode, indices.size(), in)};
+	}
+}
+} // namespace
+
+PrimitiveMode detail::list_mode(PrimitiveMode const mode) {
+	switch (mode) {
+	case PrimitiveMode::eTriangleStrip:
+	case PrimitiveMode::eTriangleFan: return PrimitiveMode::eTriangles;
+	case PrimitiveMode::eLineStrip:
+	case PrimitiveMode::eLineLoop: return PrimitiveMode::eLines;
+	default: return mode;
+	}
+}
+
+Indices detail::list_indices(Accessor const& indices, PrimitiveMode const mode) {
+	auto const& data = indices.data();
+	if (auto const* d = std::get_if<Accessor::UnsignedInt>(&data)) { return gltf2cpp::list_indices<std::uint32_t>(d->span(), mode); }
+	if (auto const* d = std::get_if<Accessor::UnsignedShort>(&data)) { return gltf2cpp::list_indices<std::uint16_t>(d->span(), mode); }
+	auto const* u8 = std::get_if<Accessor::UnsignedByte>(&data);
+	EXPECT(u8);
+	return gltf2cpp::list_indices<std::uint8_t>(u8->span(), mode);
+}
+
+bool normalize_topology(Mesh::Primitive& primitive) {
+	auto& indices = primitive.geometry.indices;
+	auto const list_mode = detail::list_mode(primitive.mode);
+	if (!indices.empty()) {
+		if (list_mode == primitive.mode) { return false; }
+		if (auto const u16 = indices.u16(); indices.is_u16()) {
+			indices = list_indices(u16, primitive.mode);
+		} else {
+			indices = list_indices(indices.u32(), primitive.mode);
+		}
+	} else {
+		auto const count = detail::vertex_count(primitive);
+		if (count == 0) { return false; }
+		EXPECT(count <= std::numeric_limits<std::uint32_t>::max());
+		auto const in = [](std::size_t const i) { return static_cast<std::uint32_t>(i); };
+		if (count <= 0x10000) {
+			indices = Indices{make_list<std::uint16_t>(primitive.mode, count, in)};
+		} else {
+			indices = Indices{make_list<std::uint32_t>(primitive.mode, count, in)};
+		}
+	}
+	primitive.mode = list_mode;
+	return true;
+}
+} // namespace gltf2cpp
@@ -0,0 +1,163 @@
+#include <detail/geometry.hpp>
+#include <detail/parallel.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/process.hpp>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace gltf2cpp {
+#define EXPECT(expr) detail::expect(!!(expr), #expr)
+
+namespace {
+constexpr std::uint32_t none_v{std::numeric_limits<std::uint32_t>::max()};
+// vertices are hashed in parallel chunks of this size
+constexpr std::size_t chunk_size_v{16 * 1024};
+// vertices are distributed across 2^partition_bits_v partitions by hash, each deduplicated independently (in parallel)
+constexpr std::size_t partition_bits_v{8};
+constexpr std::size_t partitions_v{std::size_t{1} << partition_bits_v};
+
+constexpr std::uint64_t mix(std::uint64_t value) {
+	// MurmurHash3 finalizer
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdull;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ull;
+	value ^= value >> 33;
+	return value;
+}
+
+// Every vertex vector of a Mesh Primitive, viewed as flat arrays of components.
+// Components are compared as 64 bit words: integers as-is, floats as bits or as quantized integers.
+class VertexKeys {
+  public:
+	VertexKeys(Mesh::Primitive const& primitive, float const epsilon) : m_scale(epsilon > 0.0f ? 1.0 / static_cast<double>(epsilon) : 0.0) {
+		auto const add_vertices = [this](auto const& geometry) {
+			add(geometry.positions);
+			add(geometry.normals);
+			add(geometry.tangents);
+			for (auto const& v : geometry.tex_coords) { add(v); }
+			for (auto const& v : geometry.colors) { add(v); }
+		};
+		add_vertices(primitive.geometry);
+		for (auto const& v : primitive.geometry.joints) { add(v); }
+		for (auto const& v : primitive.geometry.weights) { add(v); }
+		for (auto const& target : primitive.targets) { add_vertices(target); }
+	}
+
+	std::uint64_t hash(std::size_t const vertex) const {
+		auto ret = std::uint64_t{0xcbf29ce484222325ull};
+		for (auto const& stream : m_streams) {
+			for (std::size_t c = 0; c < stream.components; ++c) { ret = (ret ^ word(stream, vertex, c)) * 0x100000001b3ull; }
+		}
+		return mix(ret);
+	}
+
+	bool equal(std::size_t const a, std::size_t const b) const {
+		for (auto const& stream : m_streams) {
+			for (std::size_t c = 0; c < stream.components; ++c) {
+				if (word(stream, a, c) != word(stream, b, c)) { return false; }
+			}
+		}
+		return true;
+	}
+
+  private:
+	struct Stream {
+		float const* floats{};
+		std::uint32_t const* uints{};
+		std::size_t components{};
+	};
+
+	template <typename T>
+	void add(std::vector<T> const& vertices) {
+		if (vertices.empty()) { return; }
+		auto stream = Stream{.components = std::tuple_size_v<T>};
+		if constexpr (std::is_same_v<typename T::value_type, float>) {
+			stream.floats = vertices.front().data();
+		} else {
+			stream.uints = vertices.front().data();
+		}
+		m_streams.push_back(stream);
+	}
+
+	std::uint64_t word(Stream const& stream, std::size_t const vertex, std::size_t const component) const {
+		auto const index = vertex * stream.components + component;
+		if (stream.uints) { return stream.uints[index]; }
+		auto const value = stream.floats[index];
+		if (m_scale > 0.0 && std::isfinite(value)) { return static_cast<std::uint64_t>(std::llround(static_cast<double>(value) * m_scale)); }
+		// +0 and -0 are the same vertex
+		return value == 0.0f ? 0u : std::bit_cast<std::uint32_t>(value);
+	}
+
+	std::vector<Stream> m_streams{};
+	double m_scale{};
+};
+} // namespace
+
+std::size_t weld(Mesh::Primitive& primitive, Weld const& weld) {
+	auto const vertex_count = detail::vertex_count(primitive);
+	if (vertex_count == 0) { return 0; }
+	EXPECT(vertex_count < none_v);
+	auto const keys = VertexKeys{primitive, weld.epsilon};
+
+	auto hashes = std::vector<std::uint64_t>(vertex_count);
+	detail::parallel_chunks(vertex_count, weld.threads, chunk_size_v, [&](std::size_t const i) { hashes[i] = keys.hash(i); });
+
+	// stable counting sort by partition: vertices within each partition are in ascending order
+	auto const partition = [&hashes](std::size_t const vertex) { return hashes[vertex] >> (64 - partition_bits_v); };
+	auto offsets = std::vector<std::size_t>(partitions_v + 1);
+	for (std::size_t i = 0; i < vertex_count; ++i) { ++offsets[partition(i) + 1]; }
+	for (std::size_t p = 0; p < partitions_v; ++p) { offsets[p + 1] += offsets[p]; }
+	auto order = std::vector<std::uint32_t>(vertex_count);
+	auto cursors = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+	for (std::size_t i = 0; i < vertex_count; ++i) { order[cursors[partition(i)]++] = static_cast<std::uint32_t>(i); }
+
+	// first[v]: the first vertex identical to v (v itself if unique)
+	auto first = std::vector<std::uint32_t>(vertex_count);
+	// partitions are only deduplicated in parallel if there are enough vertices to hash in parallel
+	auto const partition_threads = vertex_count > chunk_size_v ? weld.threads : 1;
+	detail::parallel_for(partitions_v, partition_threads, [&](std::size_t const p) {
+		auto const members = std::span{order}.subspan(offsets[p], offsets[p + 1] - offsets[p]);
+		if (members.empty()) { return; }
+		// open addressing, at most half full
+		auto table = std::vector<std::uint32_t>(std::bit_ceil(members.size() * 2), none_v);
+		auto const mask = table.size() - 1;
+		for (auto const v : members) {
+			for (auto slot = hashes[v] & mask;; slot = (slot + 1) & mask) {
+				auto& entry = table[slot];
+				if (entry == none_v) {
+					entry = first[v] = v;
+					break;
+				}
+				if (hashes[entry] == hashes[v] && keys.equal(entry, v)) {
+					first[v] = entry;
+					break;
+				}
+			}
+		}
+	});
+
+	auto remap = std::vector<std::uint32_t>(vertex_count);
+	auto count = std::uint32_t{};
+	for (std::size_t i = 0; i < vertex_count; ++i) { remap[i] = first[i] == i ? count++ : remap[first[i]]; }
+
+	auto const& source = primitive.geometry.indices;
+	auto indices = std::vector<std::uint32_t>{};
+	auto type = ComponentType::eUnsignedInt;
+	if (source.empty()) {
+		indices = remap;
+		if (count <= 0x10000) { type = ComponentType::eUnsignedShort; }
+	} else {
+		indices = source.to_u32();
+		for (auto& index : indices) {
+			EXPECT(index < vertex_count);
+			index = remap[index];
+		}
+		type = source.component_type();
+	}
+	detail::remap_vertices(primitive, remap, count);
+	primitive.geometry.indices = detail::make_indices(std::move(indices), type);
+	return count;
+}
+} // namespace gltf2cpp
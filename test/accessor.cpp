@@ -0,0 +1,314 @@
+#include <common.hpp>
+#include <gltf2cpp/arena.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr std::string_view bounds_json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 16 } ],
+  "bufferViews" : [ { "buffer" : 0, "byteLength" : 16 } ],
+  "accessors" : [
+    {
+      "bufferView" : 0,
+      "componentType" : 5126,
+      "count" : 2,
+      "type" : "VEC2",
+      "min" : [ -1.0, 0.0 ],
+      "max" : [ 1.0, 1.0 ]
+    }
+  ]
+})";
+
+constexpr std::string_view sparse_json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 56 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 32 },
+    { "buffer" : 0, "byteOffset" : 32, "byteLength" : 8 },
+    { "buffer" : 0, "byteOffset" : 40, "byteLength" : 16 }
+  ],
+  "accessors" : [
+    {
+      "bufferView" : 0,
+      "componentType" : 5126,
+      "count" : 4,
+      "type" : "VEC2",
+      "sparse" : {
+        "count" : 2,
+        "indices" : { "bufferView" : 1, "componentType" : 5125 },
+        "values" : { "bufferView" : 2 }
+      }
+    },
+    {
+      "componentType" : 5126,
+      "count" : 4,
+      "type" : "VEC2",
+      "max" : [ 5.0, 5.0 ],
+      "sparse" : {
+        "count" : 2,
+        "indices" : { "bufferView" : 1, "componentType" : 5125 },
+        "values" : { "bufferView" : 2 }
+      }
+    }
+  ]
+})";
+
+constexpr std::string_view quantized_json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "extensionsUsed" : [ "KHR_mesh_quantization" ],
+  "extensionsRequired" : [ "KHR_mesh_quantization" ],
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 56 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 18 },
+    { "buffer" : 0, "byteOffset" : 20, "byteLength" : 9 },
+    { "buffer" : 0, "byteOffset" : 32, "byteLength" : 12 },
+    { "buffer" : 0, "byteOffset" : 44, "byteLength" : 12 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5123, "count" : 3, "type" : "VEC3", "min" : [ 0, 0, 0 ], "max" : [ 65535, 4, 5 ] },
+    { "bufferView" : 1, "componentType" : 5120, "normalized" : true, "count" : 3, "type" : "VEC3" },
+    { "bufferView" : 2, "componentType" : 5121, "normalized" : true, "count" : 3, "type" : "VEC4" },
+    { "bufferView" : 3, "componentType" : 5121, "count" : 3, "type" : "VEC4" }
+  ],
+  "meshes" : [
+    {
+      "primitives" : [ { "attributes" : { "POSITION" : 0, "NORMAL" : 1, "WEIGHTS_0" : 2, "JOINTS_0" : 3 } } ]
+    }
+  ]
+})";
+
+// 300 interleaved vertices: { float position[3]; std::uint16_t uv[2]; std::uint8_t rgba[4]; }
+constexpr std::string_view interleaved_json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 6000 } ],
+  "bufferViews" : [ { "buffer" : 0, "byteLength" : 6000, "byteStride" : 20 } ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 300, "type" : "VEC3", "max" : [ 1000.0, 0.0, 0.25 ] },
+    { "bufferView" : 0, "byteOffset" : 12, "componentType" : 5123, "count" : 300, "type" : "VEC2" },
+    { "bufferView" : 0, "byteOffset" : 16, "componentType" : 5121, "count" : 300, "type" : "VEC4" }
+  ]
+})";
+
+template <typename T>
+std::vector<std::byte> to_bytes(std::initializer_list<T> values) {
+	auto ret = std::vector<std::byte>(values.size() * sizeof(T));
+	std::memcpy(ret.data(), std::data(values), ret.size());
+	return ret;
+}
+
+gltf2cpp::Root parse(std::string_view text, std::span<std::byte const> bytes, gltf2cpp::ParseOptions const& options = {}) {
+	auto const json = dj::Json::parse(text);
+	return gltf2cpp::Parser{json}.parse([bytes](std::string_view) { return bytes; }, options);
+}
+
+void test_bounds() {
+	using Bounds = gltf2cpp::ParseOptions::Bounds;
+	auto const bytes = to_bytes<float>({-2.0f, 0.5f, 3.0f, 1.0f});
+	{
+		auto const root = parse(bounds_json_v, bytes, {.bounds = Bounds::eClamp});
+		ASSERT(root.accessors.size() == 1);
+		EXPECT(root.accessors[0].out_of_bounds());
+		EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{-1.0f, 0.5f}, {1.0f, 1.0f}}));
+	}
+	{
+		auto const root = parse(bounds_json_v, bytes, {.bounds = Bounds::eValidate});
+		ASSERT(root.accessors.size() == 1);
+		EXPECT(root.accessors[0].out_of_bounds());
+		EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{-2.0f, 0.5f}, {3.0f, 1.0f}}));
+	}
+	{
+		auto const root = parse(bounds_json_v, bytes, {.bounds = Bounds::eSkip});
+		ASSERT(root.accessors.size() == 1);
+		EXPECT(!root.accessors[0].out_of_bounds());
+		EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{-2.0f, 0.5f}, {3.0f, 1.0f}}));
+	}
+	{
+		auto const in_bounds = to_bytes<float>({-1.0f, 0.0f, 0.25f, 1.0f});
+		auto const root = parse(bounds_json_v, in_bounds, {.bounds = Bounds::eClamp});
+		ASSERT(root.accessors.size() == 1);
+		EXPECT(!root.accessors[0].out_of_bounds());
+		EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{-1.0f, 0.0f}, {0.25f, 1.0f}}));
+	}
+}
+
+void test_sparse() {
+	auto bytes = to_bytes<float>({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+	auto const indices = to_bytes<std::uint32_t>({1, 3});
+	auto const values = to_bytes<float>({-1.0f, -2.0f, 9.0f, 10.0f});
+	bytes.insert(bytes.end(), indices.begin(), indices.end());
+	bytes.insert(bytes.end(), values.begin(), values.end());
+	auto const root = parse(sparse_json_v, bytes);
+	ASSERT(root.accessors.size() == 2);
+	for (auto const& accessor : root.accessors) {
+		ASSERT(accessor.sparse.has_value());
+		EXPECT(!accessor.decoded());
+		EXPECT((accessor.sparse->indices == std::vector<std::uint32_t>{1, 3}));
+		auto const& sparse_values = std::get<gltf2cpp::Accessor::Float>(accessor.sparse->values);
+		ASSERT(sparse_values.size() == 4);
+		EXPECT(sparse_values[2] == 9.0f);
+	}
+	EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{1.0f, 2.0f}, {-1.0f, -2.0f}, {5.0f, 6.0f}, {9.0f, 10.0f}}));
+	// the base data must not have been patched in place
+	auto const& buffer = root.buffers[0].bytes;
+	auto base = std::array<float, 2>{};
+	std::memcpy(base.data(), buffer.data() + 8, sizeof(base));
+	EXPECT((base == std::array<float, 2>{3.0f, 4.0f}));
+	// no bufferView: substitutions into zeros, then clamped to max
+	EXPECT(root.accessors[1].out_of_bounds());
+	EXPECT((root.accessors[1].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{0.0f, 0.0f}, {-1.0f, -2.0f}, {0.0f, 0.0f}, {5.0f, 5.0f}}));
+}
+
+void test_quantized() {
+	auto bytes = std::vector<std::byte>(56);
+	auto write = [&bytes](std::size_t offset, std::vector<std::byte> const& in) { std::memcpy(bytes.data() + offset, in.data(), in.size()); };
+	write(0, to_bytes<std::uint16_t>({0, 1, 2, 3, 4, 5, 65535, 0, 0}));
+	write(20, to_bytes<std::int8_t>({127, 0, -128, 0, -127, 0, 64, 0, 0}));
+	write(32, to_bytes<std::uint8_t>({255, 0, 0, 0, 128, 127, 0, 0, 0, 0, 0, 255}));
+	write(44, to_bytes<std::uint8_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+	auto const root = parse(quantized_json_v, bytes);
+	ASSERT(root.meshes.size() == 1 && root.meshes[0].primitives.size() == 1);
+	auto const& geometry = root.meshes[0].primitives[0].geometry;
+	// non-normalized: converted as-is
+	EXPECT((geometry.positions == std::vector<gltf2cpp::Vec<3>>{{0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}, {65535.0f, 0.0f, 0.0f}}));
+	// normalized signed: c / 127, clamped to -1
+	EXPECT((geometry.normals == std::vector<gltf2cpp::Vec<3>>{{1.0f, 0.0f, -1.0f}, {0.0f, -1.0f, 0.0f}, {64.0f / 127.0f, 0.0f, 0.0f}}));
+	// normalized unsigned: c / 255
+	ASSERT(geometry.weights.size() == 1 && geometry.joints.size() == 1);
+	auto const expected_weights = std::vector<gltf2cpp::Vec<4>>{{1.0f, 0.0f, 0.0f, 0.0f}, {128.0f / 255.0f, 127.0f / 255.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
+	EXPECT(geometry.weights[0] == expected_weights);
+	EXPECT((geometry.joints[0] == std::vector<gltf2cpp::UVec<4>>{{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}}));
+	// quantized data remains accessible via the Accessor
+	EXPECT(std::holds_alternative<gltf2cpp::Accessor::UnsignedShort>(root.accessors[0].data()));
+}
+
+void test_keep() {
+	auto bytes = std::vector<std::byte>(56);
+	auto const data_size = [](gltf2cpp::Accessor const& accessor) { return std::visit([](auto const& d) { return d.size(); }, accessor.data()); };
+	auto const full = parse(quantized_json_v, bytes);
+	auto const full_usage = full.memory_usage();
+	EXPECT(full_usage.buffers == 56);
+	EXPECT(full_usage.geometry > 0);
+	// all accessors are packed and in bounds: views into the buffer are not counted twice
+	EXPECT(full_usage.accessors == 0);
+	{
+		auto const root = parse(quantized_json_v, bytes, {.keep = {.geometry = false}});
+		ASSERT(root.meshes.size() == 1);
+		auto const& geometry = root.meshes[0].primitives[0].geometry;
+		EXPECT(geometry.attributes.size() == 4);
+		EXPECT(geometry.positions.empty() && geometry.joints.empty() && geometry.weights.empty());
+		EXPECT(root.memory_usage().geometry == 0);
+		EXPECT(data_size(root.accessors[0]) == 9);
+	}
+	{
+		auto const root = parse(quantized_json_v, bytes, {.keep = {.buffers = false, .accessors = false}});
+		ASSERT(root.buffers.size() == 1 && root.accessors.size() == 4);
+		EXPECT(root.buffers[0].bytes.empty());
+		EXPECT(std::ranges::all_of(root.accessors, [&](gltf2cpp::Accessor const& a) { return !a.storage && data_size(a) == 0; }));
+		EXPECT(root.meshes[0].primitives[0].geometry.positions.size() == 3);
+		auto const usage = root.memory_usage();
+		EXPECT(usage.buffers == 0 && usage.accessors == 0);
+		EXPECT(usage.geometry == full_usage.geometry);
+	}
+}
+
+void test_resource() {
+	auto bytes = to_bytes<float>({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+	auto const indices = to_bytes<std::uint32_t>({1, 3});
+	auto const values = to_bytes<float>({-1.0f, -2.0f, 9.0f, 10.0f});
+	bytes.insert(bytes.end(), indices.begin(), indices.end());
+	bytes.insert(bytes.end(), values.begin(), values.end());
+	auto arena = std::make_shared<gltf2cpp::Arena>();
+	{
+		auto const root = parse(sparse_json_v, bytes, {.resource = arena});
+		// the buffer is copied into the arena
+		EXPECT(arena->allocated() == bytes.size());
+		EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{1.0f, 2.0f}, {-1.0f, -2.0f}, {5.0f, 6.0f}, {9.0f, 10.0f}}));
+		// deferred (densified) accessor data is allocated from the arena too
+		EXPECT(arena->allocated() > bytes.size());
+		EXPECT(arena.use_count() > 1);
+	}
+	// released along with the last allocation
+	EXPECT(arena.use_count() == 1);
+}
+
+void test_alignment() {
+	auto const aligned = [](void const* ptr, std::size_t alignment) { return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0; };
+	auto const floats = std::array{1.0f, 2.0f, 3.0f};
+	// copies all the bytes of a non-byte span
+	auto const copy = gltf2cpp::DynArray<float>{std::span{floats}, {.alignment = 64}};
+	EXPECT(copy.size() == 3 && aligned(copy.data(), 64));
+	EXPECT(std::equal(copy.span().begin(), copy.span().end(), floats.begin()));
+	auto uninit = gltf2cpp::DynArray<float>{128, {.alignment = 32, .initialize = false}};
+	EXPECT(uninit.size() == 128 && aligned(uninit.data(), 32));
+
+	auto bytes = to_bytes<float>({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+	auto const indices = to_bytes<std::uint32_t>({1, 3});
+	auto const values = to_bytes<float>({-1.0f, -2.0f, 9.0f, 10.0f});
+	bytes.insert(bytes.end(), indices.begin(), indices.end());
+	bytes.insert(bytes.end(), values.begin(), values.end());
+	auto const root = parse(sparse_json_v, bytes, {.resource = std::make_shared<gltf2cpp::Arena>(), .alignment = 64});
+	auto const* data = std::get_if<gltf2cpp::Accessor::Float>(&root.accessors[0].data());
+	ASSERT(data);
+	EXPECT(aligned(data->data(), 64));
+	EXPECT((root.accessors[0].to_vec<2>() == std::vector<gltf2cpp::Vec<2>>{{1.0f, 2.0f}, {-1.0f, -2.0f}, {5.0f, 6.0f}, {9.0f, 10.0f}}));
+}
+
+void test_interleaved() {
+	static constexpr std::size_t count_v{300};
+	static constexpr std::size_t stride_v{20};
+	auto bytes = std::vector<std::byte>(count_v * stride_v);
+	for (std::size_t i = 0; i < count_v; ++i) {
+		auto const position = std::array{static_cast<float>(i), -static_cast<float>(i), 0.5f};
+		auto const uv = std::array{static_cast<std::uint16_t>(i), static_cast<std::uint16_t>(2 * i)};
+		auto const rgba = std::array<std::uint8_t, 4>{static_cast<std::uint8_t>(i), 1, 2, 3};
+		auto* vertex = bytes.data() + i * stride_v;
+		std::memcpy(vertex, position.data(), sizeof(position));
+		std::memcpy(vertex + 12, uv.data(), sizeof(uv));
+		std::memcpy(vertex + 16, rgba.data(), sizeof(rgba));
+	}
+	auto const check = [](gltf2cpp::Root const& root) {
+		ASSERT(root.accessors.size() == 3);
+		auto const* positions = std::get_if<gltf2cpp::Accessor::Float>(&root.accessors[0].data());
+		auto const* uvs = std::get_if<gltf2cpp::Accessor::UnsignedShort>(&root.accessors[1].data());
+		auto const* colours = std::get_if<gltf2cpp::Accessor::UnsignedByte>(&root.accessors[2].data());
+		ASSERT(positions && uvs && colours);
+		ASSERT(positions->size() == 3 * count_v && uvs->size() == 2 * count_v && colours->size() == 4 * count_v);
+		EXPECT(root.accessors[0].out_of_bounds() && !root.accessors[1].out_of_bounds());
+		auto matched = true;
+		for (std::size_t i = 0; i < count_v; ++i) {
+			// z is clamped to max
+			matched &= (*positions)[3 * i] == static_cast<float>(i) && (*positions)[3 * i + 1] == -static_cast<float>(i) && (*positions)[3 * i + 2] == 0.25f;
+			matched &= (*uvs)[2 * i] == i && (*uvs)[2 * i + 1] == 2 * i;
+			matched &= (*colours)[4 * i] == static_cast<std::uint8_t>(i) && (*colours)[4 * i + 3] == 3;
+		}
+		EXPECT(matched);
+	};
+	using Decode = gltf2cpp::ParseOptions::Decode;
+	// eager: all three accessors are de-interleaved in a single pass over the BufferView
+	auto const eager = parse(interleaved_json_v, bytes, {.accessors = Decode::eEager});
+	EXPECT(std::ranges::all_of(eager.accessors, [](gltf2cpp::Accessor const& a) { return a.decoded(); }));
+	check(eager);
+	// deferred: each accessor is de-interleaved on access
+	auto const deferred = parse(interleaved_json_v, bytes, {.accessors = Decode::eDeferred});
+	EXPECT(std::ranges::none_of(deferred.accessors, [](gltf2cpp::Accessor const& a) { return a.decoded(); }));
+	check(deferred);
+}
+} // namespace
+
+int main() {
+	try {
+		test_bounds();
+		test_sparse();
+		test_quantized();
+		test_keep();
+		test_resource();
+		test_alignment();
+		test_interleaved();
+	} catch (...) {}
+	return test::result();
+}
@@ -0,0 +1,73 @@
+#include <common.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+std::string base64_encode(std::span<std::byte const> bytes) {
+	static constexpr std::string_view alphabet_v = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	auto ret = std::string{};
+	for (std::size_t i = 0; i < bytes.size(); i += 3) {
+		auto const remain = bytes.size() - i;
+		auto triple = std::to_integer<std::uint32_t>(bytes[i]) << 16;
+		if (remain > 1) { triple |= std::to_integer<std::uint32_t>(bytes[i + 1]) << 8; }
+		if (remain > 2) { triple |= std::to_integer<std::uint32_t>(bytes[i + 2]); }
+		ret += alphabet_v[(triple >> 18) & 0x3f];
+		ret += alphabet_v[(triple >> 12) & 0x3f];
+		ret += remain > 1 ? alphabet_v[(triple >> 6) & 0x3f] : '=';
+		ret += remain > 2 ? alphabet_v[triple & 0x3f] : '=';
+	}
+	return ret;
+}
+
+gltf2cpp::Root parse_buffer(std::string_view base64, std::size_t length) {
+	auto text = std::string{R"({ "asset": { "version": "2.0" }, "buffers": [ { "byteLength": )"};
+	text += std::to_string(length);
+	text += R"(, "uri": "data:application/octet-stream;base64,)";
+	text += base64;
+	text += R"(" } ] })";
+	auto const json = dj::Json::parse(text);
+	return gltf2cpp::Parser{json}.parse({});
+}
+
+bool throws(std::string_view base64) {
+	try {
+		parse_buffer(base64, 0);
+	} catch (gltf2cpp::Error const&) { return true; }
+	return false;
+}
+} // namespace
+
+int main() {
+	try {
+		auto bytes = std::vector<std::byte>(4099);
+		auto seed = std::uint32_t{42};
+		for (auto& byte : bytes) {
+			seed = seed * 1664525u + 1013904223u;
+			byte = static_cast<std::byte>(seed >> 24);
+		}
+		for (std::size_t length : {1, 2, 3, 11, 12, 13, 47, 48, 49, 95, 96, 97, 1000, 4099}) {
+			auto const source = std::span<std::byte const>{bytes}.first(length);
+			auto const root = parse_buffer(base64_encode(source), length);
+			ASSERT(root.buffers.size() == 1);
+			auto const decoded = root.buffers[0].bytes.span();
+			EXPECT(decoded.size() == length);
+			EXPECT(std::equal(decoded.begin(), decoded.end(), source.begin(), source.end()));
+		}
+
+		auto const valid = base64_encode(std::span<std::byte const>{bytes}.first(300));
+		EXPECT(!throws(valid));
+		EXPECT(throws(valid.substr(1)));
+		auto invalid = valid;
+		invalid[250] = '#';
+		EXPECT(throws(invalid));
+		invalid = valid;
+		invalid[8] = '=';
+		EXPECT(throws(invalid));
+		EXPECT(throws("QQ=A"));
+		EXPECT(throws("Q==="));
+	} catch (...) {}
+	return test::result();
+}
@@ -0,0 +1,113 @@
+#include <common.hpp>
+#include <gltf2cpp/bounds.hpp>
+#include <gltf2cpp/hierarchy.hpp>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 116 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 48 },
+    { "buffer" : 0, "byteOffset" : 48, "byteLength" : 60 },
+    { "buffer" : 0, "byteOffset" : 108, "byteLength" : 6 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 4, "type" : "VEC3", "min" : [ -1, 0, 0 ], "max" : [ 1, 2, 3 ] },
+    { "bufferView" : 1, "componentType" : 5126, "count" : 5, "type" : "VEC3" },
+    { "bufferView" : 2, "componentType" : 5121, "normalized" : true, "count" : 2, "type" : "VEC3", "min" : [ 0, 0, 0 ], "max" : [ 255, 51, 0 ] }
+  ],
+  "meshes" : [
+    { "primitives" : [ { "attributes" : { "POSITION" : 0 } } ] },
+    { "primitives" : [ { "attributes" : { "POSITION" : 1 } }, { "attributes" : { "POSITION" : 2 } } ] }
+  ],
+  "nodes" : [
+    { "mesh" : 0, "translation" : [ 10, 0, 0 ], "children" : [ 1 ] },
+    { "mesh" : 1, "rotation" : [ 0, 0, 0.70710678, 0.70710678 ], "scale" : [ 2, 2, 2 ] },
+    { "mesh" : 0 }
+  ],
+  "scenes" : [ { "nodes" : [ 0 ] }, { "nodes" : [ 2 ] } ]
+})";
+
+bool near(gltf2cpp::Aabb const& a, gltf2cpp::Aabb const& b) {
+	for (std::size_t i = 0; i < 3; ++i) {
+		if (std::abs(a.min[i] - b.min[i]) > 1e-5f || std::abs(a.max[i] - b.max[i]) > 1e-5f) { return false; }
+	}
+	return true;
+}
+
+void test_compute() {
+	EXPECT(gltf2cpp::compute_aabb({}).empty());
+	auto rng = std::mt19937{42};
+	auto dist = std::uniform_real_distribution<float>{-100.0f, 100.0f};
+	auto positions = std::vector<gltf2cpp::Vec<3>>{};
+	// every remainder of the vectorized loop
+	for (std::size_t count = 1; count < 40; ++count) {
+		positions.push_back({dist(rng), dist(rng), dist(rng)});
+		auto expected = gltf2cpp::Aabb{};
+		for (auto const& p : positions) { expected.merge(p); }
+		EXPECT(gltf2cpp::compute_aabb(positions) == expected);
+	}
+
+	auto const box = gltf2cpp::Aabb{.min = {-1.0f, -2.0f, -2.0f}, .max = {1.0f, 2.0f, 2.0f}};
+	auto const sphere = gltf2cpp::bounding_sphere(box);
+	EXPECT((sphere == gltf2cpp::Sphere{.center = {0.0f, 0.0f, 0.0f}, .radius = 3.0f}));
+	EXPECT(gltf2cpp::bounding_sphere({}).radius == 0.0f);
+	EXPECT(gltf2cpp::transform_aabb({}, gltf2cpp::to_matrix(gltf2cpp::Trs{})).empty());
+	EXPECT(gltf2cpp::transform_aabb(box, gltf2cpp::to_matrix(gltf2cpp::Trs{})) == box);
+}
+
+void test_parse() {
+	auto bytes = std::vector<std::byte>(116);
+	// (0, 1, 4) exceeds the declared max
+	auto const declared = std::array{-1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 2.0f, 1.0f, 0.0f, 1.0f, 4.0f};
+	auto const undeclared = std::array{0.0f, 0.0f, 0.0f, 1.0f, -1.0f, 2.0f, -3.0f, 4.0f, 0.5f, 2.0f, 2.0f, -1.0f, 0.5f, 0.5f, 0.5f};
+	auto const quantized = std::array<std::uint8_t, 6>{255, 0, 0, 0, 51, 0};
+	std::memcpy(bytes.data(), declared.data(), sizeof(declared));
+	std::memcpy(bytes.data() + 48, undeclared.data(), sizeof(undeclared));
+	std::memcpy(bytes.data() + 108, quantized.data(), sizeof(quantized));
+	auto const json = dj::Json::parse(json_v);
+	auto const parse = [&](gltf2cpp::ParseOptions const& options) {
+		return gltf2cpp::Parser{json}.parse([&bytes](std::string_view) { return std::span<std::byte const>{bytes}; }, options);
+	};
+
+	auto const root = parse({});
+	ASSERT(root.meshes.size() == 2 && root.meshes[1].primitives.size() == 2);
+	// taken from min / max (data is clamped)
+	EXPECT((root.meshes[0].primitives[0].aabb == gltf2cpp::Aabb{.min = {-1.0f, 0.0f, 0.0f}, .max = {1.0f, 2.0f, 3.0f}}));
+	// computed from positions
+	EXPECT((root.meshes[1].primitives[0].aabb == gltf2cpp::Aabb{.min = {-3.0f, -1.0f, -1.0f}, .max = {2.0f, 4.0f, 2.0f}}));
+	// dequantized
+	EXPECT((root.meshes[1].primitives[1].aabb == gltf2cpp::Aabb{.min = {0.0f, 0.0f, 0.0f}, .max = {1.0f, 0.2f, 0.0f}}));
+	EXPECT(root.meshes[0].primitives[0].sphere == gltf2cpp::bounding_sphere(root.meshes[0].primitives[0].aabb));
+
+	// data exceeding min / max is not clamped: positions are scanned instead
+	auto const validated = parse({.bounds = gltf2cpp::ParseOptions::Bounds::eValidate});
+	EXPECT((validated.meshes[0].primitives[0].aabb == gltf2cpp::Aabb{.min = {-1.0f, 0.0f, 0.0f}, .max = {1.0f, 2.0f, 4.0f}}));
+
+	// min / max do not require Geometry
+	auto const bare = parse({.keep = {.geometry = false}});
+	EXPECT(bare.meshes[0].primitives[0].aabb == root.meshes[0].primitives[0].aabb);
+	EXPECT(bare.meshes[1].primitives[0].aabb.empty());
+
+	auto const world = gltf2cpp::world_bounds(root);
+	ASSERT(world.nodes.size() == 3 && world.scenes.size() == 2);
+	EXPECT(near(world.nodes[0], {.min = {9.0f, 0.0f, 0.0f}, .max = {11.0f, 2.0f, 3.0f}}));
+	// T(10, 0, 0) * R(z, 90) * S(2)
+	EXPECT(near(world.nodes[1], {.min = {2.0f, -6.0f, -2.0f}, .max = {12.0f, 4.0f, 4.0f}}));
+	EXPECT(world.nodes[2] == root.meshes[0].primitives[0].aabb);
+	EXPECT(near(world.scenes[0], {.min = {2.0f, -6.0f, -2.0f}, .max = {12.0f, 4.0f, 4.0f}}));
+	EXPECT(world.scenes[1] == world.nodes[2]);
+}
+} // namespace
+
+int main() {
+	try {
+		test_compute();
+		test_parse();
+	} catch (...) {}
+	return test::result();
+}
@@ -0,0 +1,133 @@
+#include <common.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+constexpr std::string_view json_v = R"({
+  "scene": 0,
+  "scenes" : [ { "nodes" : [ 0 ] } ],
+  "nodes" : [ { "mesh" : 0 } ],
+  "meshes" : [
+    {
+      "primitives" : [ {
+        "attributes" : {
+          "POSITION" : 1
+        },
+        "indices" : 0
+      } ]
+    }
+  ],
+  "buffers" : [ { "byteLength" : 44 } ],
+  "bufferViews" : [
+    {
+      "buffer" : 0,
+      "byteOffset" : 0,
+      "byteLength" : 6,
+      "target" : 34963
+    },
+    {
+      "buffer" : 0,
+      "byteOffset" : 8,
+      "byteLength" : 36,
+      "target" : 34962
+    }
+  ],
+  "accessors" : [
+    {
+      "bufferView" : 0,
+      "byteOffset" : 0,
+      "componentType" : 5123,
+      "count" : 3,
+      "type" : "SCALAR",
+      "max" : [ 2 ],
+      "min" : [ 0 ]
+    },
+    {
+      "bufferView" : 1,
+      "byteOffset" : 0,
+      "componentType" : 5126,
+      "count" : 3,
+      "type" : "VEC3",
+      "max" : [ 1.0, 1.0, 0.0 ],
+      "min" : [ 0.0, 0.0, 0.0 ]
+    }
+  ],
+  "asset" : {
+    "version" : "2.0"
+  }
+}
+)";
+
+void append_u32(std::vector<std::byte>& out, std::uint32_t value) {
+	auto const offset = out.size();
+	out.resize(offset + sizeof(value));
+	std::memcpy(out.data() + offset, &value, sizeof(value));
+}
+
+void append_chunk(std::vector<std::byte>& out, std::uint32_t type, std::span<std::byte const> data, std::byte pad) {
+	auto const padded = (data.size() + 3) / 4 * 4;
+	append_u32(out, static_cast<std::uint32_t>(padded));
+	append_u32(out, type);
+	out.insert(out.end(), data.begin(), data.end());
+	out.resize(out.size() + padded - data.size(), pad);
+}
+
+gltf2cpp::ByteArray make_glb() {
+	auto bin = std::vector<std::byte>(44);
+	std::uint16_t const indices[] = {0, 1, 2};
+	float const positions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+	std::memcpy(bin.data(), indices, sizeof(indices));
+	std::memcpy(bin.data() + 8, positions, sizeof(positions));
+	auto chunks = std::vector<std::byte>{};
+	append_chunk(chunks, 0x4E4F534A, std::as_bytes(std::span{json_v}), std::byte{' '});
+	append_chunk(chunks, 0x004E4942, bin, std::byte{});
+	auto glb = std::vector<std::byte>{};
+	append_u32(glb, 0x46546C67);
+	append_u32(glb, 2);
+	append_u32(glb, static_cast<std::uint32_t>(12 + chunks.size()));
+	glb.insert(glb.end(), chunks.begin(), chunks.end());
+	return gltf2cpp::ByteArray{std::span<std::byte const>{glb}};
+}
+} // namespace
+
+int main() {
+	try {
+		auto const bytes = make_glb();
+		ASSERT(gltf2cpp::Glb::is_glb(bytes.span()));
+		auto glb = gltf2cpp::Glb::from(bytes);
+		ASSERT(!glb.json.is_null());
+		ASSERT(glb.bin.size() == 44);
+		auto const* bin = glb.bin.data();
+		auto root = gltf2cpp::Parser{glb.json, std::move(glb.bin)}.parse({});
+		ASSERT(root.buffers.size() == 1);
+		EXPECT(root.buffers[0].bytes.data() == bin);
+		EXPECT(root.buffers[0].bytes.size() == 44);
+		ASSERT(root.accessors.size() == 2);
+		auto const& positions = std::get<gltf2cpp::Accessor::Float>(root.accessors[1].data());
+		EXPECT(reinterpret_cast<std::byte const*>(positions.data()) == bin + 8);
+		ASSERT(root.meshes.size() == 1);
+		ASSERT(root.meshes[0].primitives.size() == 1);
+		auto const& primitive = root.meshes[0].primitives[0];
+		ASSERT(primitive.geometry.positions.size() == 3);
+		ASSERT(primitive.geometry.indices.size() == 3);
+		EXPECT(primitive.geometry.indices[2] == 2);
+		EXPECT((primitive.geometry.positions[1] == gltf2cpp::Vec<3>{1.0f, 0.0f, 0.0f}));
+		EXPECT((primitive.geometry.positions[2] == gltf2cpp::Vec<3>{0.0f, 1.0f, 0.0f}));
+
+		auto const path = std::filesystem::temp_directory_path() / "gltf2cpp-test.glb";
+		{
+			auto file = std::ofstream{path, std::ios::binary};
+			file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		}
+		auto const mapped = gltf2cpp::parse(path.string().c_str(), {.threads = 4});
+		std::filesystem::remove(path);
+		ASSERT(!!mapped);
+		ASSERT(mapped.meshes.size() == 1);
+		EXPECT(mapped.meshes[0].primitives[0].geometry.positions == primitive.geometry.positions);
+		EXPECT(mapped.meshes[0].primitives[0].geometry.indices == primitive.geometry.indices);
+	} catch (...) {}
+	return test::result();
+}
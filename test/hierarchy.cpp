@@ -0,0 +1,153 @@
+#include <common.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/hierarchy.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+bool near(gltf2cpp::Mat4x4 const& a, gltf2cpp::Mat4x4 const& b) {
+	for (std::size_t c = 0; c < 4; ++c) {
+		for (std::size_t r = 0; r < 4; ++r) {
+			if (std::abs(a[c][r] - b[c][r]) > 1e-4f * std::max(1.0f, std::abs(b[c][r]))) { return false; }
+		}
+	}
+	return true;
+}
+
+gltf2cpp::Mat4x4 multiply(gltf2cpp::Mat4x4 const& a, gltf2cpp::Mat4x4 const& b) {
+	auto ret = gltf2cpp::Mat4x4{};
+	for (std::size_t c = 0; c < 4; ++c) {
+		for (std::size_t r = 0; r < 4; ++r) {
+			for (std::size_t k = 0; k < 4; ++k) { ret[c][r] += a[k][r] * b[c][k]; }
+		}
+	}
+	return ret;
+}
+
+// world matrix by recursion through parents
+gltf2cpp::Mat4x4 reference(gltf2cpp::Root const& root, gltf2cpp::Index<gltf2cpp::Node> const node) {
+	auto const local = gltf2cpp::to_matrix(root.nodes[node].transform);
+	if (!root.nodes[node].parent) { return local; }
+	return multiply(reference(root, *root.nodes[node].parent), local);
+}
+
+// random forest with shuffled Node indices (parents do not necessarily precede their children); every 7th Node has a matrix
+gltf2cpp::Root make_forest(std::size_t const count, std::mt19937& rng) {
+	auto order = std::vector<std::size_t>(count);
+	std::iota(order.begin(), order.end(), std::size_t{});
+	std::shuffle(order.begin(), order.end(), rng);
+	auto dist = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+	auto ret = gltf2cpp::Root{};
+	ret.nodes.resize(count);
+	auto& scene = ret.scenes.emplace_back();
+	for (std::size_t i = 0; i < count; ++i) {
+		auto& node = ret.nodes[order[i]];
+		node.self = order[i];
+		auto q = gltf2cpp::Vec<4>{dist(rng), dist(rng), dist(rng), dist(rng)};
+		auto const length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+		for (auto& f : q) { f /= length; }
+		auto const trs = gltf2cpp::Trs{
+			.translation = {dist(rng), dist(rng), dist(rng)},
+			.rotation = q,
+			.scale = {1.0f + 0.1f * dist(rng), 1.0f + 0.1f * dist(rng), 1.0f + 0.1f * dist(rng)},
+		};
+		node.transform = trs;
+		if (i % 7 == 3) { node.transform = gltf2cpp::to_matrix(trs); }
+		if (i % 50 == 0) {
+			scene.root_nodes.push_back(order[i]);
+			continue;
+		}
+		auto const parent = order[std::uniform_int_distribution<std::size_t>{i > 8 ? i - 8 : 0, i - 1}(rng)];
+		node.parent = parent;
+		ret.nodes[parent].children.push_back(order[i]);
+	}
+	return ret;
+}
+
+void test_to_matrix() {
+	auto const s = std::sqrt(0.5f);
+	// 90 degrees about z, then scale, then translate
+	auto const matrix = gltf2cpp::to_matrix(gltf2cpp::Trs{.translation = {1.0f, 2.0f, 3.0f}, .rotation = {0.0f, 0.0f, s, s}, .scale = {2.0f, 2.0f, 2.0f}});
+	auto const expected = gltf2cpp::Mat4x4{{
+		gltf2cpp::Vec<4>{0.0f, 2.0f, 0.0f, 0.0f},
+		gltf2cpp::Vec<4>{-2.0f, 0.0f, 0.0f, 0.0f},
+		gltf2cpp::Vec<4>{0.0f, 0.0f, 2.0f, 0.0f},
+		gltf2cpp::Vec<4>{1.0f, 2.0f, 3.0f, 1.0f},
+	}};
+	EXPECT(near(matrix, expected));
+	EXPECT(gltf2cpp::to_matrix(expected) == expected);
+}
+
+void test_hierarchy() {
+	auto rng = std::mt19937{42};
+	auto root = make_forest(1001, rng);
+	// not part of any Scene, but still parentless
+	root.nodes.push_back(gltf2cpp::Node{.transform = gltf2cpp::Trs{.translation = {5.0f, 0.0f, 0.0f}}, .self = root.nodes.size()});
+	auto hierarchy = gltf2cpp::TransformHierarchy{root};
+	ASSERT(hierarchy.size() == root.nodes.size());
+
+	// parents precede their children, and subtrees are contiguous
+	auto ordered = true;
+	for (std::size_t entry = 0; entry < hierarchy.size(); ++entry) {
+		auto const node = hierarchy.nodes()[entry];
+		ordered &= hierarchy.entry(node) == entry;
+		auto const parent = hierarchy.parents()[entry];
+		if (parent == gltf2cpp::TransformHierarchy::npos_v) {
+			ordered &= !root.nodes[node].parent;
+			continue;
+		}
+		ordered &= parent < entry && hierarchy.nodes()[parent] == *root.nodes[node].parent;
+		// entries between a Node and its child are descendants of that Node (subtrees are contiguous)
+		for (auto e = parent + 1; e < entry; ++e) {
+			auto ancestor = hierarchy.parents()[e];
+			while (ancestor != gltf2cpp::TransformHierarchy::npos_v && ancestor > parent) { ancestor = hierarchy.parents()[ancestor]; }
+			ordered &= ancestor == parent;
+		}
+	}
+	EXPECT(ordered);
+
+	auto const matches = [&] {
+		for (std::size_t node = 0; node < root.nodes.size(); ++node) {
+			if (!near(hierarchy.world(node), reference(root, node))) { return false; }
+		}
+		return true;
+	};
+	EXPECT(matches());
+	EXPECT(hierarchy.update() == 0);
+
+	// leaf: only itself is re-evaluated
+	auto const is_leaf = [](gltf2cpp::Node const& n) { return n.children.empty(); };
+	auto const leaf = static_cast<gltf2cpp::Index<gltf2cpp::Node>>(std::ranges::find_if(root.nodes, is_leaf) - root.nodes.begin());
+	root.nodes[leaf].transform = gltf2cpp::Trs{.translation = {0.0f, 1.0f, 0.0f}};
+	hierarchy.set_local(leaf, root.nodes[leaf].transform);
+	EXPECT(hierarchy.update() == 1);
+	EXPECT(matches());
+
+	// scene root: its whole subtree is re-evaluated, including neighbouring matrices
+	auto const scene_root = root.scenes[0].root_nodes[1];
+	auto const first = hierarchy.entry(scene_root);
+	auto last = first + 1;
+	while (last < hierarchy.size() && hierarchy.parents()[last] != gltf2cpp::TransformHierarchy::npos_v) { ++last; }
+	root.nodes[scene_root].transform = gltf2cpp::Trs{.rotation = {1.0f, 0.0f, 0.0f, 0.0f}, .scale = {3.0f, 3.0f, 3.0f}};
+	hierarchy.set_local(scene_root, root.nodes[scene_root].transform);
+	EXPECT(hierarchy.update() == last - first);
+	EXPECT(matches());
+
+	auto threw = false;
+	try {
+		hierarchy.set_local(root.nodes.size(), gltf2cpp::Trs{});
+	} catch (gltf2cpp::Error const&) { threw = true; }
+	EXPECT(threw);
+}
+} // namespace
+
+int main() {
+	try {
+		test_to_matrix();
+		test_hierarchy();
+	} catch (...) {}
+	return test::result();
+}
@@ -0,0 +1,79 @@
+#include <common.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace {
+// u8 (37), u16 (1003), u32 (5) indices: counts exercise both the vectorized blocks and the scalar tails
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 2068 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 37 },
+    { "buffer" : 0, "byteOffset" : 40, "byteLength" : 2006 },
+    { "buffer" : 0, "byteOffset" : 2048, "byteLength" : 20 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5121, "count" : 37, "type" : "SCALAR" },
+    { "bufferView" : 1, "componentType" : 5123, "count" : 1003, "type" : "SCALAR" },
+    { "bufferView" : 2, "componentType" : 5125, "count" : 5, "type" : "SCALAR" }
+  ],
+  "meshes" : [
+    {
+      "primitives" : [ { "attributes" : {}, "indices" : 1 } ]
+    }
+  ]
+})";
+
+template <typename T>
+void write_iota(std::vector<std::byte>& out, std::size_t offset, std::size_t count, T first) {
+	auto values = std::vector<T>(count);
+	std::iota(values.begin(), values.end(), first);
+	std::memcpy(out.data() + offset, values.data(), count * sizeof(T));
+}
+
+template <typename T>
+bool is_iota(T const& values, std::uint32_t first) {
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		if (values[i] != first + i) { return false; }
+	}
+	return true;
+}
+
+void test_indices() {
+	auto bytes = std::vector<std::byte>(2068);
+	write_iota<std::uint8_t>(bytes, 0, 37, 200);
+	write_iota<std::uint16_t>(bytes, 40, 1003, 60000);
+	write_iota<std::uint32_t>(bytes, 2048, 5, 70000);
+	auto const json = dj::Json::parse(json_v);
+	auto const root = gltf2cpp::Parser{json}.parse([&bytes](std::string_view) { return std::span<std::byte const>{bytes}; });
+	ASSERT(root.accessors.size() == 3 && root.meshes.size() == 1);
+
+	// u8 is widened to u16
+	auto const u8 = root.accessors[0].to_indices();
+	EXPECT(u8.is_u16() && u8.size() == 37 && is_iota(u8.u16(), 200));
+	EXPECT(is_iota(root.accessors[0].to_u32(), 200));
+
+	// u16 is kept at native width
+	auto const& indices = root.meshes[0].primitives[0].geometry.indices;
+	ASSERT(indices.size() == 1003);
+	EXPECT(indices.component_type() == gltf2cpp::ComponentType::eUnsignedShort);
+	EXPECT(indices.bytes().size() == 1003 * sizeof(std::uint16_t) && indices.u32().empty());
+	EXPECT(indices[1002] == 61002);
+	EXPECT(is_iota(indices, 60000));
+	EXPECT(is_iota(indices.to_u32(), 60000));
+	EXPECT(indices == root.accessors[1].to_indices());
+
+	auto const u32 = root.accessors[2].to_indices();
+	EXPECT(!u32.is_u16() && u32.component_type() == gltf2cpp::ComponentType::eUnsignedInt);
+	EXPECT(is_iota(u32.u32(), 70000) && is_iota(u32.to_u32(), 70000));
+}
+} // namespace
+
+int main() {
+	try {
+		test_indices();
+	} catch (...) {}
+	return test::result();
+}
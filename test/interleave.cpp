@@ -0,0 +1,119 @@
+#include <common.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/interleave.hpp>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 48 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 24 },
+    { "buffer" : 0, "byteOffset" : 24, "byteLength" : 16 },
+    { "buffer" : 0, "byteOffset" : 40, "byteLength" : 6 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 2, "type" : "VEC3" },
+    { "bufferView" : 1, "componentType" : 5126, "count" : 2, "type" : "VEC2" },
+    { "bufferView" : 2, "componentType" : 5121, "normalized" : true, "count" : 2, "type" : "VEC3" }
+  ],
+  "meshes" : [
+    {
+      "primitives" : [ { "attributes" : { "POSITION" : 0, "TEXCOORD_0" : 1, "COLOR_0" : 2 } } ]
+    }
+  ]
+})";
+
+struct Vertex {
+	std::array<float, 3> position{};
+	std::array<std::uint16_t, 2> uv{};
+	std::array<std::uint8_t, 4> rgba{};
+	std::array<float, 3> normal{};
+};
+static_assert(sizeof(Vertex) == 32);
+
+template <typename T>
+void write(std::vector<std::byte>& out, std::size_t offset, std::initializer_list<T> values) {
+	std::memcpy(out.data() + offset, std::data(values), values.size() * sizeof(T));
+}
+
+void test_interleave() {
+	auto bytes = std::vector<std::byte>(48);
+	write<float>(bytes, 0, {1.0f, 2.0f, 3.0f, -1.0f, -2.0f, -3.0f});
+	write<float>(bytes, 24, {0.0f, 0.5f, 1.0f, 2.0f});
+	write<std::uint8_t>(bytes, 40, {255, 0, 128, 0, 255, 64});
+	auto const json = dj::Json::parse(json_v);
+	auto const root = gltf2cpp::Parser{json}.parse([&bytes](std::string_view) { return std::span<std::byte const>{bytes}; });
+	ASSERT(root.meshes.size() == 1 && root.meshes[0].primitives.size() == 1);
+	auto const& primitive = root.meshes[0].primitives[0];
+
+	auto const layout = gltf2cpp::VertexLayout{
+		.attributes =
+			{
+				{.semantic = "POSITION", .offset = offsetof(Vertex, position)},
+				{.semantic = "TEXCOORD_0", .component_type = gltf2cpp::ComponentType::eUnsignedShort, .components = 2, .normalized = true, .offset = offsetof(Vertex, uv)},
+				{.semantic = "COLOR_0", .component_type = gltf2cpp::ComponentType::eUnsignedByte, .components = 4, .normalized = true, .offset = offsetof(Vertex, rgba)},
+				{.semantic = "NORMAL", .offset = offsetof(Vertex, normal)},
+			},
+		.stride = sizeof(Vertex),
+	};
+	auto const vertices = gltf2cpp::interleave(primitive, root.accessors, layout);
+	ASSERT(vertices.count == 2 && vertices.stride == sizeof(Vertex));
+	ASSERT(vertices.bytes.size() == 2 * sizeof(Vertex));
+	auto out = std::array<Vertex, 2>{};
+	std::memcpy(out.data(), vertices.bytes.data(), vertices.bytes.size());
+
+	EXPECT((out[0].position == std::array{1.0f, 2.0f, 3.0f}));
+	EXPECT((out[1].position == std::array{-1.0f, -2.0f, -3.0f}));
+	// floats are normalized, rounded, and saturated
+	EXPECT((out[0].uv == std::array<std::uint16_t, 2>{0, 32768}));
+	EXPECT((out[1].uv == std::array<std::uint16_t, 2>{65535, 65535}));
+	// vec3 colours are padded with alpha = 1
+	EXPECT((out[0].rgba == std::array<std::uint8_t, 4>{255, 0, 128, 255}));
+	EXPECT((out[1].rgba == std::array<std::uint8_t, 4>{0, 255, 64, 255}));
+	// absent attributes are zero-filled
+	EXPECT((out[0].normal == std::array{0.0f, 0.0f, 0.0f}));
+
+	auto invalid = layout;
+	invalid.stride = 16;
+	auto threw = false;
+	try {
+		gltf2cpp::interleave(primitive, root.accessors, invalid);
+	} catch (gltf2cpp::Error const&) { threw = true; }
+	EXPECT(threw);
+
+	invalid = layout;
+	invalid.attributes[0].component_type = static_cast<gltf2cpp::ComponentType>(0);
+	threw = false;
+	try {
+		gltf2cpp::interleave(primitive, root.accessors, invalid);
+	} catch (gltf2cpp::Error const&) { threw = true; }
+	EXPECT(threw);
+
+	// no padding: every byte is written by an Attribute
+	auto const packed = gltf2cpp::VertexLayout{
+		.attributes =
+			{
+				{.semantic = "POSITION", .offset = 0},
+				{.semantic = "COLOR_0", .component_type = gltf2cpp::ComponentType::eUnsignedByte, .components = 4, .normalized = true, .offset = 12},
+			},
+		.stride = 16,
+	};
+	auto const packed_vertices = gltf2cpp::interleave(primitive, root.accessors, packed);
+	ASSERT(packed_vertices.bytes.size() == 32);
+	auto rgba = std::array<std::uint8_t, 4>{};
+	std::memcpy(rgba.data(), packed_vertices.bytes.data() + 16 + 12, sizeof(rgba));
+	EXPECT((rgba == std::array<std::uint8_t, 4>{0, 255, 64, 255}));
+	EXPECT(std::memcmp(packed_vertices.bytes.data(), vertices.bytes.data(), 12) == 0);
+}
+} // namespace
+
+int main() {
+	try {
+		test_interleave();
+	} catch (...) {}
+	return test::result();
+}
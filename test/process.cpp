@@ -0,0 +1,430 @@
+#include <common.hpp>
+#include <gltf2cpp/process.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+using Triangle = std::array<gltf2cpp::Vec<3>, 3>;
+
+// triangles as position triples, rotated to start at the smallest vertex (winding is preserved), sorted
+std::vector<Triangle> triangles(gltf2cpp::Geometry const& geometry) {
+	auto ret = std::vector<Triangle>{};
+	for (std::size_t i = 0; i + 2 < geometry.indices.size(); i += 3) {
+		auto t = Triangle{geometry.positions[geometry.indices[i]], geometry.positions[geometry.indices[i + 1]], geometry.positions[geometry.indices[i + 2]]};
+		std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+		ret.push_back(t);
+	}
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+
+// average cache miss ratio (misses per triangle) of a FIFO cache
+float acmr(gltf2cpp::Indices const& indices, std::size_t const cache_size = 16) {
+	auto cache = std::vector<std::uint32_t>{};
+	auto misses = std::size_t{};
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		if (std::find(cache.begin(), cache.end(), indices[i]) != cache.end()) { continue; }
+		++misses;
+		cache.push_back(indices[i]);
+		if (cache.size() > cache_size) { cache.erase(cache.begin()); }
+	}
+	return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+// side x side grid of quads, with shuffled vertices and triangles
+gltf2cpp::Mesh::Primitive make_grid(std::size_t const side) {
+	auto const vertices = side + 1;
+	auto order = std::vector<std::uint32_t>(vertices * vertices);
+	for (std::uint32_t i = 0; i < order.size(); ++i) { order[i] = i; }
+	auto rng = std::mt19937{42};
+	std::shuffle(order.begin(), order.end(), rng);
+
+	auto ret = gltf2cpp::Mesh::Primitive{};
+	auto& geometry = ret.geometry;
+	geometry.positions.resize(order.size());
+	for (std::size_t y = 0; y < vertices; ++y) {
+		for (std::size_t x = 0; x < vertices; ++x) { geometry.positions[order[y * vertices + x]] = {static_cast<float>(x), static_cast<float>(y), 0.0f}; }
+	}
+	// every other attribute is derived from the position, so that consistency can be checked after remapping
+	auto& uvs = geometry.tex_coords.emplace_back();
+	auto& joints = geometry.joints.emplace_back();
+	auto& weights = geometry.weights.emplace_back();
+	auto& target = ret.targets.emplace_back();
+	for (auto const& p : geometry.positions) {
+		uvs.push_back({p[0], p[1]});
+		joints.push_back({static_cast<std::uint32_t>(p[0]), static_cast<std::uint32_t>(p[1]), 0, 0});
+		weights.push_back({p[0], p[1], 0.0f, 0.0f});
+		target.positions.push_back({p[0], p[1], 1.0f});
+	}
+
+	auto quads = std::vector<std::array<std::uint32_t, 6>>{};
+	for (std::size_t y = 0; y < side; ++y) {
+		for (std::size_t x = 0; x < side; ++x) {
+			auto const v = [&](std::size_t dx, std::size_t dy) { return order[(y + dy) * vertices + x + dx]; };
+			quads.push_back({v(0, 0), v(1, 0), v(1, 1), v(0, 0), v(1, 1), v(0, 1)});
+		}
+	}
+	std::shuffle(quads.begin(), quads.end(), rng);
+	auto indices = std::vector<std::uint16_t>{};
+	for (auto const& quad : quads) { indices.insert(indices.end(), quad.begin(), quad.end()); }
+	geometry.indices = gltf2cpp::Indices{std::move(indices)};
+	return ret;
+}
+
+void test_optimize() {
+	auto primitive = make_grid(32);
+	auto const source = triangles(primitive.geometry);
+	auto const source_acmr = acmr(primitive.geometry.indices);
+	ASSERT(gltf2cpp::optimize(primitive));
+	auto const& geometry = primitive.geometry;
+
+	EXPECT(geometry.indices.is_u16() && geometry.indices.size() == 32 * 32 * 6);
+	EXPECT(triangles(geometry) == source);
+	auto const optimized_acmr = acmr(geometry.indices);
+	EXPECT(optimized_acmr < 0.75f && optimized_acmr < source_acmr);
+
+	// vertices are numbered in order of first use
+	auto next = std::uint32_t{};
+	for (std::size_t i = 0; i < geometry.indices.size(); ++i) {
+		if (geometry.indices[i] == next) { ++next; }
+		EXPECT(geometry.indices[i] < next);
+	}
+	// every attribute is remapped consistently
+	auto consistent = true;
+	for (std::size_t i = 0; i < geometry.positions.size(); ++i) {
+		auto const& p = geometry.positions[i];
+		consistent &= geometry.tex_coords[0][i] == gltf2cpp::Vec<2>{p[0], p[1]};
+		consistent &= geometry.joints[0][i][0] == static_cast<std::uint32_t>(p[0]) && geometry.joints[0][i][1] == static_cast<std::uint32_t>(p[1]);
+		consistent &= geometry.weights[0][i][0] == p[0] && geometry.weights[0][i][1] == p[1];
+		consistent &= primitive.targets[0].positions[i] == gltf2cpp::Vec<3>{p[0], p[1], 1.0f};
+	}
+	EXPECT(consistent);
+
+	auto lines = make_grid(2);
+	lines.mode = gltf2cpp::PrimitiveMode::eLines;
+	EXPECT(!gltf2cpp::optimize(lines));
+}
+
+// expand an indexed primitive into a triangle soup (every vertex duplicated per use)
+gltf2cpp::Mesh::Primitive unindex(gltf2cpp::Mesh::Primitive const& source) {
+	auto ret = gltf2cpp::Mesh::Primitive{};
+	auto const expand = [&source](auto const& in) {
+		auto out = std::remove_cvref_t<decltype(in)>{};
+		for (std::size_t i = 0; i < source.geometry.indices.size(); ++i) { out.push_back(in[source.geometry.indices[i]]); }
+		return out;
+	};
+	ret.geometry.positions = expand(source.geometry.positions);
+	ret.geometry.tex_coords.push_back(expand(source.geometry.tex_coords[0]));
+	ret.geometry.joints.push_back(expand(source.geometry.joints[0]));
+	ret.geometry.weights.push_back(expand(source.geometry.weights[0]));
+	ret.targets.emplace_back().positions = expand(source.targets[0].positions);
+	return ret;
+}
+
+void test_weld() {
+	auto const grid = make_grid(16);
+	auto const soup = unindex(grid);
+	ASSERT(soup.geometry.positions.size() == 16 * 16 * 6);
+
+	auto welded = soup;
+	EXPECT(gltf2cpp::weld(welded) == 17 * 17);
+	EXPECT(welded.geometry.positions.size() == 17 * 17 && welded.targets[0].positions.size() == 17 * 17);
+	EXPECT(welded.geometry.indices.is_u16() && welded.geometry.indices.size() == soup.geometry.positions.size());
+	EXPECT(triangles(welded.geometry) == triangles(grid.geometry));
+	// vertices keep their relative order (first occurrences)
+	EXPECT(welded.geometry.positions[0] == soup.geometry.positions[0] && welded.geometry.indices[0] == 0);
+
+	// identical output regardless of the thread count
+	auto threaded = soup;
+	EXPECT(gltf2cpp::weld(threaded, {.threads = 4}) == 17 * 17);
+	EXPECT(threaded.geometry.positions == welded.geometry.positions && threaded.geometry.indices == welded.geometry.indices);
+	EXPECT(threaded.geometry.joints == welded.geometry.joints && threaded.targets[0].positions == welded.targets[0].positions);
+
+	// vertices that differ in any attribute (including morph targets) are not merged
+	auto morphed = soup;
+	morphed.targets[0].positions[1][2] = 2.0f;
+	EXPECT(gltf2cpp::weld(morphed) == 17 * 17 + 1);
+
+	// nearby vertices are merged when quantized
+	auto noisy = soup;
+	for (std::size_t i = 0; i < noisy.geometry.positions.size(); ++i) { noisy.geometry.positions[i][2] += (i % 2 == 0 ? 1e-5f : -1e-5f); }
+	auto exact = noisy;
+	EXPECT(gltf2cpp::weld(exact) > 17 * 17);
+	EXPECT(gltf2cpp::weld(noisy, {.epsilon = 1e-3f}) == 17 * 17);
+
+	// indexed primitives keep their width
+	auto indexed = grid;
+	auto u32 = indexed.geometry.indices.to_u32();
+	indexed.geometry.indices = gltf2cpp::Indices{std::move(u32)};
+	EXPECT(gltf2cpp::weld(indexed) == 17 * 17);
+	EXPECT(!indexed.geometry.indices.is_u16());
+	EXPECT(triangles(indexed.geometry) == triangles(grid.geometry));
+}
+
+void test_topology() {
+	using Mode = gltf2cpp::PrimitiveMode;
+	auto primitive = gltf2cpp::Mesh::Primitive{};
+	primitive.geometry.positions.resize(6);
+	auto const normalize = [&primitive](Mode mode, std::vector<std::uint32_t> indices) {
+		primitive.mode = mode;
+		primitive.geometry.indices = gltf2cpp::Indices{std::move(indices)};
+		return gltf2cpp::normalize_topology(primitive);
+	};
+	auto const list = [&primitive](std::vector<std::uint32_t> indices) { return primitive.geometry.indices == gltf2cpp::Indices{std::move(indices)}; };
+
+	// winding alternates as per the spec
+	EXPECT(normalize(Mode::eTriangleStrip, {0, 1, 2, 3, 4}));
+	EXPECT(primitive.mode == Mode::eTriangles && list({0, 1, 2, 1, 3, 2, 2, 3, 4}));
+	// degenerate (stitching) triangles are dropped
+	EXPECT(normalize(Mode::eTriangleStrip, {0, 1, 2, 2, 3, 3, 4, 5}));
+	EXPECT(list({0, 1, 2, 3, 5, 4}));
+	EXPECT(normalize(Mode::eTriangleFan, {5, 0, 1, 2}));
+	EXPECT(list({0, 1, 5, 1, 2, 5}));
+	EXPECT(normalize(Mode::eLineLoop, {0, 1, 2}));
+	EXPECT(primitive.mode == Mode::eLines && list({0, 1, 1, 2, 2, 0}));
+	EXPECT(normalize(Mode::eLineStrip, {0, 1, 2}));
+	EXPECT(list({0, 1, 1, 2}));
+	// indexed lists are left as-is
+	EXPECT(!normalize(Mode::eTriangles, {0, 1, 2}));
+
+	// unindexed primitives are given indices
+	primitive.geometry.indices = {};
+	primitive.mode = Mode::eTriangles;
+	EXPECT(gltf2cpp::normalize_topology(primitive));
+	EXPECT((primitive.geometry.indices == gltf2cpp::Indices{std::vector<std::uint16_t>{0, 1, 2, 3, 4, 5}}));
+	primitive.geometry.indices = {};
+	primitive.mode = Mode::eTriangleStrip;
+	EXPECT(gltf2cpp::normalize_topology(primitive));
+	EXPECT(primitive.mode == Mode::eTriangles && primitive.geometry.indices.size() == 12);
+}
+
+template <std::size_t Dim>
+bool near(gltf2cpp::Vec<Dim> const& a, gltf2cpp::Vec<Dim> const& b) {
+	for (std::size_t i = 0; i < Dim; ++i) {
+		if (std::abs(a[i] - b[i]) > 1e-5f) { return false; }
+	}
+	return true;
+}
+
+// unit cube centred at the origin: 8 shared vertices, 12 outward facing triangles
+gltf2cpp::Mesh::Primitive make_cube() {
+	auto ret = gltf2cpp::Mesh::Primitive{};
+	for (std::size_t i = 0; i < 8; ++i) { ret.geometry.positions.push_back({i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f}); }
+	ret.geometry.indices = gltf2cpp::Indices{std::vector<std::uint16_t>{
+		0, 2, 3, 0, 3, 1, // -z
+		4, 5, 7, 4, 7, 6, // +z
+		0, 4, 6, 0, 6, 2, // -x
+		1, 3, 7, 1, 7, 5, // +x
+		0, 1, 5, 0, 5, 4, // -y
+		2, 6, 7, 2, 7, 3, // +y
+	}};
+	return ret;
+}
+
+void test_normals() {
+	using Mode = gltf2cpp::Normals::Mode;
+	auto const cube = make_cube();
+	auto const face_normal = [](gltf2cpp::Geometry const& geometry, std::size_t triangle) {
+		auto const& a = geometry.positions[geometry.indices[triangle * 3]];
+		auto const& b = geometry.positions[geometry.indices[triangle * 3 + 1]];
+		auto const& c = geometry.positions[geometry.indices[triangle * 3 + 2]];
+		auto const u = gltf2cpp::Vec<3>{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+		auto const v = gltf2cpp::Vec<3>{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+		return gltf2cpp::Vec<3>{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+	};
+
+	// flat: each cube corner is split into one vertex per face
+	auto flat = cube;
+	ASSERT(gltf2cpp::generate_normals(flat));
+	EXPECT(flat.geometry.positions.size() == 24 && flat.geometry.normals.size() == 24 && flat.geometry.indices.is_u16());
+	EXPECT(triangles(flat.geometry) == triangles(cube.geometry));
+	auto flat_normals = true;
+	for (std::size_t t = 0; t < 12; ++t) {
+		for (std::size_t c = 0; c < 3; ++c) { flat_normals &= near(flat.geometry.normals[flat.geometry.indices[t * 3 + c]], face_normal(flat.geometry, t)); }
+	}
+	EXPECT(flat_normals);
+
+	// smooth: vertices are shared, normals point along the diagonals (each face subtends 90 degrees at each corner)
+	auto smooth = cube;
+	ASSERT(gltf2cpp::generate_normals(smooth, {.mode = Mode::eSmooth}));
+	EXPECT(smooth.geometry.positions.size() == 8 && smooth.geometry.indices == cube.geometry.indices);
+	auto smooth_normals = true;
+	for (std::size_t v = 0; v < 8; ++v) {
+		auto const& p = smooth.geometry.positions[v];
+		auto const s = 1.0f / std::sqrt(3.0f);
+		smooth_normals &= near(smooth.geometry.normals[v], {p[0] > 0.0f ? s : -s, p[1] > 0.0f ? s : -s, p[2] > 0.0f ? s : -s});
+	}
+	EXPECT(smooth_normals);
+
+	// the cube's edges (90 degrees) are sharper than the crease angle
+	auto creased = cube;
+	ASSERT(gltf2cpp::generate_normals(creased, {.mode = Mode::eSmooth, .crease_angle = 1.0f}));
+	EXPECT(creased.geometry.positions.size() == 24 && creased.geometry.normals == flat.geometry.normals);
+
+	// morph targets get normal displacements: tilting the plane z = 0 to z = x
+	auto grid = make_grid(8);
+	grid.targets[0].positions.clear();
+	for (auto const& p : grid.geometry.positions) { grid.targets[0].positions.push_back({0.0f, 0.0f, p[0]}); }
+	auto threaded = grid;
+	ASSERT(gltf2cpp::generate_normals(grid, {.mode = Mode::eSmooth}));
+	EXPECT(gltf2cpp::generate_normals(threaded, {.mode = Mode::eSmooth, .threads = 4}));
+	EXPECT(grid.geometry.normals == threaded.geometry.normals && grid.targets[0].normals == threaded.targets[0].normals);
+	EXPECT(grid.geometry.positions.size() == 81 && grid.targets[0].normals.size() == 81);
+	auto const s = 1.0f / std::sqrt(2.0f);
+	EXPECT(std::ranges::all_of(grid.geometry.normals, [](gltf2cpp::Vec<3> const& n) { return near(n, {0.0f, 0.0f, 1.0f}); }));
+	EXPECT(std::ranges::all_of(grid.targets[0].normals, [s](gltf2cpp::Vec<3> const& n) { return near(n, {-s, 0.0f, s - 1.0f}); }));
+
+	auto lines = cube;
+	lines.mode = gltf2cpp::PrimitiveMode::eLines;
+	EXPECT(!gltf2cpp::generate_normals(lines));
+}
+
+void test_tangents() {
+	auto primitive = make_grid(8);
+	auto& geometry = primitive.geometry;
+	geometry.normals.assign(geometry.positions.size(), {0.0f, 0.0f, 1.0f});
+	// uv = xy: tangent = +x, bitangent = +y = cross(normal, tangent)
+	ASSERT(gltf2cpp::generate_tangents(primitive));
+	ASSERT(geometry.tangents.size() == geometry.positions.size());
+	EXPECT(std::ranges::all_of(geometry.tangents, [](gltf2cpp::Vec<4> const& t) { return near(t, {1.0f, 0.0f, 0.0f, 1.0f}); }));
+
+	// mirrored u: tangent = -x, bitangent = +y = -cross(normal, tangent)
+	for (auto& uv : geometry.tex_coords[0]) { uv[0] = -uv[0]; }
+	auto const single = [&] {
+		auto ret = primitive;
+		EXPECT(gltf2cpp::generate_tangents(ret));
+		return ret.geometry.tangents;
+	}();
+	EXPECT(std::ranges::all_of(single, [](gltf2cpp::Vec<4> const& t) { return near(t, {-1.0f, 0.0f, 0.0f, -1.0f}); }));
+
+	// u mirrored about x = 4: the 9 vertices on the mirror line are split, each side gets its own tangent space
+	auto mirrored = primitive;
+	for (std::size_t i = 0; i < mirrored.geometry.positions.size(); ++i) { mirrored.geometry.tex_coords[0][i][0] = 4.0f - std::abs(mirrored.geometry.positions[i][0] - 4.0f); }
+	auto mirrored_threaded = mirrored;
+	ASSERT(gltf2cpp::generate_tangents(mirrored) && gltf2cpp::generate_tangents(mirrored_threaded, {.threads = 4}));
+	EXPECT(mirrored.geometry.tangents == mirrored_threaded.geometry.tangents && mirrored.geometry.indices == mirrored_threaded.geometry.indices);
+	EXPECT(mirrored.geometry.positions.size() == 90 && mirrored.geometry.tangents.size() == 90 && mirrored.geometry.tex_coords[0].size() == 90);
+	EXPECT(mirrored.geometry.indices.is_u16() && triangles(mirrored.geometry) == triangles(primitive.geometry));
+	auto const sided = [&mirrored] {
+		auto const& g = mirrored.geometry;
+		for (std::size_t i = 0; i + 2 < g.indices.size(); i += 3) {
+			auto const left = g.positions[g.indices[i]][0] + g.positions[g.indices[i + 1]][0] + g.positions[g.indices[i + 2]][0] < 12.0f;
+			auto const expected = left ? gltf2cpp::Vec<4>{1.0f, 0.0f, 0.0f, 1.0f} : gltf2cpp::Vec<4>{-1.0f, 0.0f, 0.0f, -1.0f};
+			for (std::size_t c = 0; c < 3; ++c) {
+				if (!near(g.tangents[g.indices[i + c]], expected)) { return false; }
+			}
+		}
+		return true;
+	};
+	EXPECT(sided());
+
+	// tangents are orthogonal to (non-planar) normals, and identical regardless of the thread count
+	for (auto& n : geometry.normals) { n = {0.0f, 0.6f, 0.8f}; }
+	auto threaded = primitive;
+	EXPECT(gltf2cpp::generate_tangents(primitive) && gltf2cpp::generate_tangents(threaded, {.threads = 4}));
+	EXPECT(geometry.tangents == threaded.geometry.tangents);
+	EXPECT(std::ranges::all_of(geometry.tangents, [](gltf2cpp::Vec<4> const& t) { return std::abs(t[1] * 0.6f + t[2] * 0.8f) < 1e-5f; }));
+
+	auto missing = primitive;
+	missing.geometry.normals.clear();
+	EXPECT(!gltf2cpp::generate_tangents(missing));
+	EXPECT(!gltf2cpp::generate_tangents(primitive, {.tex_coord = 1}));
+}
+
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 64 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 48 },
+    { "buffer" : 0, "byteOffset" : 48, "byteLength" : 12 },
+    { "buffer" : 0, "byteOffset" : 60, "byteLength" : 4 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 4, "type" : "VEC3" },
+    { "bufferView" : 1, "componentType" : 5123, "count" : 6, "type" : "SCALAR" },
+    { "bufferView" : 2, "componentType" : 5121, "count" : 4, "type" : "SCALAR" }
+  ],
+  "meshes" : [
+    {
+      "primitives" : [ { "attributes" : { "POSITION" : 0, "TANGENT" : 0 }, "indices" : 1 } ]
+    },
+    {
+      "primitives" : [ { "attributes" : { "POSITION" : 0 }, "indices" : 2, "mode" : 5 }, { "attributes" : { "POSITION" : 0 }, "mode" : 6 } ]
+    }
+  ]
+})";
+
+void test_parse() {
+	auto bytes = std::vector<std::byte>(64);
+	auto const positions = std::array{0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f};
+	auto const indices = std::array<std::uint16_t, 6>{3, 2, 1, 1, 2, 0};
+	std::memcpy(bytes.data(), positions.data(), sizeof(positions));
+	auto const strip_indices = std::array<std::uint8_t, 4>{0, 1, 2, 3};
+	std::memcpy(bytes.data() + 48, indices.data(), sizeof(indices));
+	std::memcpy(bytes.data() + 60, strip_indices.data(), sizeof(strip_indices));
+	auto const json = dj::Json::parse(json_v);
+	auto const parse = [&](gltf2cpp::ParseOptions const& options) {
+		return gltf2cpp::Parser{json}.parse([&bytes](std::string_view) { return std::span<std::byte const>{bytes}; }, options);
+	};
+	auto const source = parse({});
+	auto const root = parse({.process = {.optimize = true}});
+	ASSERT(root.meshes.size() == 2 && root.meshes[0].primitives.size() == 1);
+	auto const& geometry = root.meshes[0].primitives[0].geometry;
+	EXPECT(triangles(geometry) == triangles(source.meshes[0].primitives[0].geometry));
+	EXPECT(geometry.indices[0] == 0 && geometry.indices[1] == 1 && geometry.indices[2] == 2);
+	EXPECT(geometry.normals.empty());
+	auto const with_normals = parse({.process = {.normals = true}});
+	auto const& normals = with_normals.meshes[0].primitives[0].geometry.normals;
+	EXPECT(normals.size() == 4 && std::ranges::all_of(normals, [](gltf2cpp::Vec<3> const& n) { return near(n, {0.0f, 0.0f, 1.0f}); }));
+	// output is identical regardless of ParseOptions::threads (0: hardware concurrency)
+	auto const stages = gltf2cpp::ParseOptions::Process{.weld = true, .normals = true, .crease_angle = 1.0f, .tangents = true};
+	auto const processed = parse({.process = stages});
+	auto const same = [&processed](gltf2cpp::Root const& other) {
+		auto const& a = processed.meshes[0].primitives[0].geometry;
+		auto const& b = other.meshes[0].primitives[0].geometry;
+		return a.positions == b.positions && a.normals == b.normals && a.tangents == b.tangents && a.indices == b.indices;
+	};
+	EXPECT(same(parse({.process = stages, .threads = 4})));
+	EXPECT(same(parse({.process = stages, .threads = 0})));
+	// a single primitive: its stages are split across threads instead
+	auto single_json = std::string{json_v.substr(0, json_v.find(R"(  "meshes")"))};
+	single_json += R"(  "meshes" : [ { "primitives" : [ { "attributes" : { "POSITION" : 0, "TANGENT" : 0 }, "indices" : 1 } ] } ]
+})";
+	auto const single = dj::Json::parse(single_json);
+	EXPECT(same(gltf2cpp::Parser{single}.parse([&bytes](std::string_view) { return std::span<std::byte const>{bytes}; }, {.process = stages, .threads = 0})));
+	// vec3 tangents are right handed
+	EXPECT(geometry.tangents.size() == 4 && std::ranges::all_of(geometry.tangents, [](gltf2cpp::Vec<4> const& t) { return t[3] == 1.0f; }));
+	// Accessors are left as-is
+	EXPECT(root.accessors[1].to_u32() == source.accessors[1].to_u32());
+
+	EXPECT(source.meshes[1].primitives[0].mode == gltf2cpp::PrimitiveMode::eTriangleStrip);
+	auto const normalized = parse({.process = {.normalize_topology = true}});
+	ASSERT(normalized.meshes.size() == 2 && normalized.meshes[1].primitives.size() == 2);
+	// u8 strip: decoded, widened, and converted in one pass
+	auto const& strip = normalized.meshes[1].primitives[0];
+	EXPECT(strip.mode == gltf2cpp::PrimitiveMode::eTriangles);
+	EXPECT((strip.geometry.indices == gltf2cpp::Indices{std::vector<std::uint16_t>{0, 1, 2, 1, 3, 2}}));
+	// unindexed fan: indices are synthesized
+	auto const& fan = normalized.meshes[1].primitives[1];
+	EXPECT(fan.mode == gltf2cpp::PrimitiveMode::eTriangles);
+	EXPECT((fan.geometry.indices == gltf2cpp::Indices{std::vector<std::uint16_t>{1, 2, 0, 2, 3, 0}}));
+}
+} // namespace
+
+int main() {
+	try {
+		test_optimize();
+		test_weld();
+		test_topology();
+		test_tangents();
+		test_normals();
+		test_parse();
+	} catch (...) {}
+	return test::result();
+}
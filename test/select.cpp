@@ -0,0 +1,117 @@
+#include <common.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "scene" : 0,
+  "scenes" : [ { "nodes" : [ 0 ] }, { "nodes" : [ 1 ] } ],
+  "nodes" : [
+    { "mesh" : 0 },
+    { "mesh" : 1, "children" : [ 2 ] },
+    { "skin" : 0 }
+  ],
+  "buffers" : [ { "uri" : "a.bin", "byteLength" : 28 }, { "uri" : "b.bin", "byteLength" : 76 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 12 },
+    { "buffer" : 0, "byteOffset" : 12, "byteLength" : 4 },
+    { "buffer" : 0, "byteOffset" : 16, "byteLength" : 12 },
+    { "buffer" : 1, "byteOffset" : 0, "byteLength" : 12 },
+    { "buffer" : 1, "byteOffset" : 12, "byteLength" : 64 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 1, "type" : "VEC3" },
+    { "bufferView" : 3, "componentType" : 5126, "count" : 1, "type" : "VEC3" },
+    { "bufferView" : 4, "componentType" : 5126, "count" : 1, "type" : "MAT4" },
+    { "bufferView" : 1, "componentType" : 5126, "count" : 1, "type" : "SCALAR" },
+    { "bufferView" : 2, "componentType" : 5126, "count" : 1, "type" : "VEC3" }
+  ],
+  "meshes" : [
+    { "primitives" : [ { "attributes" : { "POSITION" : 0 }, "material" : 0 } ] },
+    { "primitives" : [ { "attributes" : { "POSITION" : 1 } } ] }
+  ],
+  "materials" : [ { "pbrMetallicRoughness" : { "baseColorTexture" : { "index" : 0 } } } ],
+  "textures" : [ { "source" : 0 } ],
+  "images" : [ { "uri" : "used.png" }, { "uri" : "unused.png" } ],
+  "skins" : [ { "joints" : [ 2 ], "inverseBindMatrices" : 2 } ],
+  "animations" : [
+    {
+      "samplers" : [ { "input" : 3, "output" : 4 } ],
+      "channels" : [ { "sampler" : 0, "target" : { "node" : 0, "path" : "translation" } } ]
+    }
+  ]
+})";
+
+struct Loader {
+	std::vector<std::byte> bytes = std::vector<std::byte>(76);
+	std::vector<std::string> loaded{};
+
+	gltf2cpp::Root parse(gltf2cpp::ParseOptions::Select const& select) {
+		loaded.clear();
+		auto const json = dj::Json::parse(json_v);
+		auto ret = gltf2cpp::Parser{json}.parse(
+			[this](std::string_view uri) {
+				loaded.emplace_back(uri);
+				return std::span<std::byte const>{bytes};
+			},
+			{.select = select});
+		std::ranges::sort(loaded);
+		return ret;
+	}
+};
+
+void test_scene() {
+	auto loader = Loader{};
+	{
+		auto const root = loader.parse({.scene = 1});
+		EXPECT((loader.loaded == std::vector<std::string>{"b.bin"}));
+		// indices remain stable
+		ASSERT(root.nodes.size() == 3 && root.meshes.size() == 2 && root.accessors.size() == 5 && root.images.size() == 2);
+		EXPECT(root.meshes[0].primitives.empty());
+		EXPECT(root.meshes[1].primitives.size() == 1);
+		ASSERT(root.skins.size() == 1);
+		EXPECT(root.skins[0].inverse_bind_matrices.size() == 1);
+		ASSERT(root.animations.size() == 1);
+		EXPECT(root.animations[0].samplers.empty());
+		EXPECT(!root.accessors[0].storage && root.accessors[1].storage);
+		EXPECT(root.images[0].bytes.empty() && root.images[1].bytes.empty());
+	}
+	{
+		auto const root = loader.parse({.scene = 0});
+		EXPECT((loader.loaded == std::vector<std::string>{"a.bin", "used.png"}));
+		EXPECT(root.meshes[0].primitives.size() == 1 && root.meshes[1].primitives.empty());
+		EXPECT(root.animations[0].samplers.size() == 1);
+		EXPECT(root.skins[0].inverse_bind_matrices.empty());
+		EXPECT(!root.images[0].bytes.empty() && root.images[1].bytes.empty());
+	}
+}
+
+void test_categories() {
+	auto loader = Loader{};
+	{
+		// hierarchy and metadata only
+		auto const root = loader.parse({.meshes = false, .images = false, .animations = false, .skins = false});
+		EXPECT(loader.loaded.empty());
+		EXPECT(root.nodes.size() == 3 && root.scenes.size() == 2 && root.materials.size() == 1);
+		EXPECT(std::ranges::all_of(root.meshes, [](gltf2cpp::Mesh const& m) { return m.primitives.empty(); }));
+	}
+	{
+		auto const root = loader.parse({.images = false, .animations = false});
+		EXPECT((loader.loaded == std::vector<std::string>{"a.bin", "b.bin"}));
+		EXPECT(root.meshes[0].primitives.size() == 1 && root.meshes[1].primitives.size() == 1);
+		EXPECT(root.animations[0].samplers.empty());
+		EXPECT(!root.accessors[3].storage && !root.accessors[4].storage);
+	}
+}
+} // namespace
+
+int main() {
+	try {
+		test_scene();
+		test_categories();
+	} catch (...) {}
+	return test::result();
+}
@@ -0,0 +1,85 @@
+#include <common.hpp>
+#include <gltf2cpp/error.hpp>
+#include <gltf2cpp/vertex.hpp>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 48 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 24 },
+    { "buffer" : 0, "byteOffset" : 24, "byteLength" : 8 },
+    { "buffer" : 0, "byteOffset" : 32, "byteLength" : 6 },
+    { "buffer" : 0, "byteOffset" : 40, "byteLength" : 8 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 2, "type" : "VEC3" },
+    { "bufferView" : 1, "componentType" : 5123, "normalized" : true, "count" : 2, "type" : "VEC2" },
+    { "bufferView" : 2, "componentType" : 5121, "normalized" : true, "count" : 2, "type" : "VEC3" },
+    { "bufferView" : 3, "componentType" : 5121, "normalized" : true, "count" : 2, "type" : "VEC4" }
+  ],
+  "meshes" : [
+    {
+      "primitives" : [ { "attributes" : { "POSITION" : 0, "TEXCOORD_0" : 1, "COLOR_0" : 2, "COLOR_1" : 3 } } ]
+    }
+  ]
+})";
+
+struct Vertex {
+	gltf2cpp::Vec<3> position{};
+	float uv[2]{};
+	std::array<std::uint8_t, 4> rgba{};
+	std::array<float, 4> tint{};
+	float unused{-1.0f};
+};
+
+template <typename T>
+void write(std::vector<std::byte>& out, std::size_t offset, std::initializer_list<T> values) {
+	std::memcpy(out.data() + offset, std::data(values), values.size() * sizeof(T));
+}
+
+void test_extract() {
+	auto bytes = std::vector<std::byte>(48);
+	write<float>(bytes, 0, {1.0f, 2.0f, 3.0f, -1.0f, -2.0f, -3.0f});
+	write<std::uint16_t>(bytes, 24, {0, 65535, 32768, 0});
+	write<std::uint8_t>(bytes, 32, {255, 0, 128, 0, 255, 64});
+	write<std::uint8_t>(bytes, 40, {255, 0, 0, 0, 0, 51, 0, 204});
+	auto const json = dj::Json::parse(json_v);
+	auto const root = gltf2cpp::Parser{json}.parse([&bytes](std::string_view) { return std::span<std::byte const>{bytes}; });
+	ASSERT(root.meshes.size() == 1 && root.meshes[0].primitives.size() == 1);
+	auto const& primitive = root.meshes[0].primitives[0];
+
+	auto vertices = std::array<Vertex, 2>{};
+	auto const count = gltf2cpp::extract_vertices(vertices, primitive, root.accessors, gltf2cpp::VertexField{&Vertex::position, "POSITION"},
+												  gltf2cpp::VertexField{&Vertex::uv, "TEXCOORD_0"}, gltf2cpp::VertexField{&Vertex::rgba, "COLOR_0"},
+												  gltf2cpp::VertexField{&Vertex::tint, "COLOR_1"}, gltf2cpp::VertexField{&Vertex::unused, "TEXCOORD_1"});
+	ASSERT(count == 2);
+	EXPECT((vertices[0].position == gltf2cpp::Vec<3>{1.0f, 2.0f, 3.0f}));
+	EXPECT((vertices[1].position == gltf2cpp::Vec<3>{-1.0f, -2.0f, -3.0f}));
+	// normalized integers are dequantized into floats
+	EXPECT(vertices[0].uv[0] == 0.0f && vertices[0].uv[1] == 1.0f);
+	EXPECT(vertices[1].uv[0] == 32768.0f / 65535.0f && vertices[1].uv[1] == 0.0f);
+	// integers are copied as-is into integers, normalized vec3 colours are padded with opaque alpha
+	EXPECT((vertices[0].rgba == std::array<std::uint8_t, 4>{255, 0, 128, 255}));
+	EXPECT((vertices[1].tint == std::array{0.0f, 51.0f / 255.0f, 0.0f, 204.0f / 255.0f}));
+	// absent attributes are left untouched
+	EXPECT(vertices[0].unused == -1.0f);
+
+	auto small = std::array<Vertex, 1>{};
+	auto threw = false;
+	try {
+		gltf2cpp::extract_vertices(small, primitive, root.accessors, gltf2cpp::VertexField{&Vertex::position, "POSITION"});
+	} catch (gltf2cpp::Error const&) { threw = true; }
+	EXPECT(threw);
+}
+} // namespace
+
+int main() {
+	try {
+		test_extract();
+	} catch (...) {}
+	return test::result();
+}
@@ -0,0 +1,100 @@
+#include <common.hpp>
+#include <gltf2cpp/gltf2cpp.hpp>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+constexpr std::string_view json_v = R"({
+  "asset" : { "version" : "2.0" },
+  "buffers" : [ { "uri" : "buffer.bin", "byteLength" : 40 } ],
+  "bufferViews" : [
+    { "buffer" : 0, "byteOffset" : 0, "byteLength" : 12 },
+    { "buffer" : 0, "byteOffset" : 12, "byteLength" : 12 },
+    { "buffer" : 0, "byteOffset" : 24, "byteLength" : 4 },
+    { "buffer" : 0, "byteOffset" : 28, "byteLength" : 12 }
+  ],
+  "accessors" : [
+    { "bufferView" : 0, "componentType" : 5126, "count" : 1, "type" : "VEC3" },
+    { "bufferView" : 1, "componentType" : 5126, "count" : 1, "type" : "VEC3" },
+    { "bufferView" : 2, "componentType" : 5126, "count" : 1, "type" : "SCALAR" },
+    { "bufferView" : 3, "componentType" : 5126, "count" : 1, "type" : "VEC3" }
+  ],
+  "meshes" : [
+    { "primitives" : [ { "attributes" : { "POSITION" : 0 } } ] },
+    { "primitives" : [ { "attributes" : { "POSITION" : 1, "_SHARED" : 0 } } ] }
+  ],
+  "images" : [ { "uri" : "image.png" } ],
+  "animations" : [
+    {
+      "samplers" : [ { "input" : 2, "output" : 3 } ],
+      "channels" : [ { "sampler" : 0, "target" : { "path" : "translation" } } ]
+    }
+  ]
+})";
+
+void test_visitor() {
+	auto const bytes = std::vector<std::byte>(40);
+	auto mutex = std::mutex{};
+	auto primitives = std::vector<std::pair<gltf2cpp::Index<gltf2cpp::Mesh>, gltf2cpp::Mesh::Primitive>>{};
+	auto images = std::vector<gltf2cpp::Image>{};
+	auto animations = std::vector<gltf2cpp::Animation>{};
+	auto accessors_alive = true;
+	auto kept = std::vector<gltf2cpp::Accessor::Data>{};
+
+	auto visitor = gltf2cpp::Visitor{};
+	visitor.on_primitive = [&](gltf2cpp::Index<gltf2cpp::Mesh> mesh, std::size_t index, gltf2cpp::Mesh::Primitive& primitive,
+							   std::span<gltf2cpp::Accessor const> accessors) {
+		auto lock = std::scoped_lock{mutex};
+		// accessors must remain alive until all primitives referencing them have been visited
+		for (auto const& [_, accessor] : primitive.geometry.attributes) { accessors_alive &= accessors[accessor].storage != nullptr; }
+		// shared data outlives the Accessor's storage
+		auto const& positions = accessors[primitive.geometry.attributes.at("POSITION")];
+		kept.push_back(std::visit([](auto const& d) { return gltf2cpp::Accessor::Data{d.share()}; }, positions.data()));
+		EXPECT(index == 0);
+		primitives.emplace_back(mesh, std::move(primitive));
+	};
+	visitor.on_image = [&](gltf2cpp::Index<gltf2cpp::Image>, gltf2cpp::Image& image) {
+		auto lock = std::scoped_lock{mutex};
+		images.push_back(std::move(image));
+	};
+	visitor.on_animation = [&](gltf2cpp::Index<gltf2cpp::Animation>, gltf2cpp::Animation& animation, std::span<gltf2cpp::Accessor const>) {
+		auto lock = std::scoped_lock{mutex};
+		animations.push_back(std::move(animation));
+	};
+
+	auto const json = dj::Json::parse(json_v);
+	auto const get_bytes = [&bytes](std::string_view) { return std::span<std::byte const>{bytes}; };
+	auto const root = gltf2cpp::Parser{json}.parse(get_bytes, {.accessors = gltf2cpp::ParseOptions::Decode::eDeferred, .visitor = visitor, .threads = 2});
+
+	EXPECT(accessors_alive);
+	ASSERT(primitives.size() == 2);
+	std::ranges::sort(primitives, [](auto const& a, auto const& b) { return a.first < b.first; });
+	EXPECT(primitives[0].second.geometry.positions.size() == 1 && primitives[1].second.geometry.positions.size() == 1);
+	ASSERT(images.size() == 1 && animations.size() == 1);
+	EXPECT(!images[0].bytes.empty());
+	EXPECT(animations[0].samplers.size() == 1 && animations[0].samplers[0].input.size() == 1);
+
+	// Root only retains placeholders
+	ASSERT(root.meshes.size() == 2 && root.images.size() == 1 && root.animations.size() == 1);
+	EXPECT(std::ranges::all_of(root.meshes, [](gltf2cpp::Mesh const& m) { return m.primitives.size() == 1 && m.primitives[0].geometry.attributes.empty(); }));
+	EXPECT(root.images[0].bytes.empty());
+	EXPECT(root.animations[0].samplers.empty());
+	// accessors used only by primitives are released, animation accessors are retained
+	ASSERT(root.accessors.size() == 4);
+	EXPECT(!root.accessors[0].storage && !root.accessors[1].storage);
+	ASSERT(kept.size() == 2);
+	for (auto const& data : kept) {
+		auto const* floats = std::get_if<gltf2cpp::Accessor::Float>(&data);
+		EXPECT(floats && floats->size() == 3 && (*floats)[0] == 0.0f);
+	}
+	EXPECT(root.accessors[2].storage && root.accessors[3].storage);
+}
+} // namespace
+
+int main() {
+	try {
+		test_visitor();
+	} catch (...) {}
+	return test::result();
+}